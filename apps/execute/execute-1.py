@@ -35,7 +35,7 @@
 #
 ##########################################################################
 
-import os, sys, traceback
+import os, sys, traceback, json, time, resource
 
 import imath
 
@@ -109,6 +109,37 @@ class execute( Gaffer.Application ) :
 					},
 				),
 
+				IECore.FileNameParameter(
+					name = "report",
+					description = "A JSON file to write an execution report to, containing "
+						"the wall time, CPU time, peak memory usage and I/O volume of "
+						"the execution, along with the usage of the compute cache. This "
+						"is used by the LocalDispatcher to record a timeline for each job.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
+				IECore.BoolParameter(
+					name = "performanceMonitor",
+					description = "Includes a summary of hash and compute statistics in "
+						"the execution report, gathered with a PerformanceMonitor.",
+					defaultValue = False,
+				),
+
+				IECore.BoolParameter(
+					name = "worker",
+					description = "Runs as a persistent worker process, which loads "
+						"the script once and then executes batches requested on stdin, "
+						"one JSON object per line, each with \"nodes\", \"frames\" and "
+						"\"context\" entries matching the parameters above, and an "
+						"optional \"report\" entry. The exit "
+						"status of each batch is written to stdout as a single line. "
+						"This is used by the LocalDispatcher to avoid the cost of loading "
+						"the script for every batch.",
+					defaultValue = False,
+				),
+
 			]
 
 		)
@@ -121,6 +152,15 @@ class execute( Gaffer.Application ) :
 
 	def _run( self, args ) :
 
+		responses = None
+		if args["worker"].value :
+			# Reserve the original stdout for our responses, and send
+			# anything else written to it (by a PythonCommand for instance)
+			# to stderr instead.
+			sys.stdout.flush()
+			responses = os.fdopen( os.dup( 1 ), "w" )
+			os.dup2( 2, 1 )
+
 		scriptNode = Gaffer.ScriptNode()
 		scriptNode["fileName"].setValue( os.path.abspath( args["script"].value ) )
 		try :
@@ -131,9 +171,107 @@ class execute( Gaffer.Application ) :
 
 		self.root()["scripts"].addChild( scriptNode )
 
+		if responses is not None :
+			return self.__runWorker( scriptNode, responses, args["performanceMonitor"].value )
+
+		return self.__executeWithReport(
+			args["report"].value,
+			args["performanceMonitor"].value,
+			scriptNode,
+			args["nodes"],
+			self.parameters()["frames"].getFrameListValue().asList(),
+			args["context"]
+		)
+
+	def __runWorker( self, scriptNode, responses, performanceMonitor ) :
+
+		while True :
+
+			request = sys.stdin.readline()
+			if not request :
+				# Dispatcher has closed our stdin, so there's no
+				# more work to do.
+				return 0
+
+			request = json.loads( request )
+			result = self.__executeWithReport(
+				str( request.get( "report", "" ) ),
+				performanceMonitor,
+				scriptNode,
+				[ str( n ) for n in request["nodes"] ],
+				IECore.FrameList.parse( str( request["frames"] ) ).asList(),
+				[ str( c ) for c in request["context"] ],
+			)
+
+			responses.write( "%d\n" % result )
+			responses.flush()
+
+	def __executeWithReport( self, reportFileName, performanceMonitor, scriptNode, nodeNames, frames, contextArgs ) :
+
+		if not reportFileName :
+			return self.__execute( scriptNode, nodeNames, frames, contextArgs )
+
+		# Resource usage is measured as the difference between the start
+		# and end of the execution, so that each batch executed by a worker
+		# gets its own report. The exception is peak memory usage, which
+		# can only be measured for the process as a whole.
+
+		usageTypes = ( resource.RUSAGE_SELF, resource.RUSAGE_CHILDREN )
+		startUsage = [ resource.getrusage( t ) for t in usageTypes ]
+		startTime = time.time()
+
+		monitor = None
+		if performanceMonitor :
+			monitor = Gaffer.PerformanceMonitor()
+			with monitor :
+				result = self.__execute( scriptNode, nodeNames, frames, contextArgs )
+		else :
+			result = self.__execute( scriptNode, nodeNames, frames, contextArgs )
+
+		endTime = time.time()
+		endUsage = [ resource.getrusage( t ) for t in usageTypes ]
+
+		def usageDelta( field ) :
+			return sum( getattr( e, field ) - getattr( s, field ) for s, e in zip( startUsage, endUsage ) )
+
+		report = {
+			"nodes" : list( nodeNames ),
+			"frames" : list( frames ),
+			"result" : result,
+			"startTime" : startTime,
+			"wallTime" : endTime - startTime,
+			"userTime" : usageDelta( "ru_utime" ),
+			"systemTime" : usageDelta( "ru_stime" ),
+			"maxRSS" : max( u.ru_maxrss for u in endUsage ),
+			"blocksIn" : usageDelta( "ru_inblock" ),
+			"blocksOut" : usageDelta( "ru_oublock" ),
+			"cacheMemoryUsage" : Gaffer.ValuePlug.cacheMemoryUsage(),
+			"cacheMemoryLimit" : Gaffer.ValuePlug.getCacheMemoryLimit(),
+		}
+
+		if monitor is not None :
+			statistics = monitor.combinedStatistics()
+			report["performance"] = {
+				"hashCount" : statistics.hashCount,
+				"computeCount" : statistics.computeCount,
+				"hashDuration" : statistics.hashDuration,
+				"computeDuration" : statistics.computeDuration,
+			}
+
+		try :
+			with open( reportFileName, "w" ) as f :
+				json.dump( report, f, indent = 4, sort_keys = True )
+		except Exception as exception :
+			IECore.msg( IECore.Msg.Level.Error, "gaffer execute : writing report \"%s\"" % reportFileName, str( exception ) )
+			return 1
+
+		return result
+
+	def __execute( self, scriptNode, nodeNames, frames, contextArgs ) :
+
 		nodes = []
-		if len( args["nodes"] ) :
-			for nodeName in args["nodes"] :
+		if len( nodeNames ) :
+			for nodeName in nodeNames :
 				node = scriptNode.descendant( nodeName )
 				if node is None :
 					IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Node \"%s\" does not exist" % nodeName )
@@ -150,16 +288,15 @@ class execute( Gaffer.Application ) :
 				IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Script has no executable nodes" )
 				return 1
 
-		if len(args["context"]) % 2 :
+		if len( contextArgs ) % 2 :
 			IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Context parameter must have matching entry/value pairs" )
 			return 1
 
 		context = Gaffer.Context( scriptNode.context() )
-		for i in range( 0, len(args["context"]), 2 ) :
-			entry = args["context"][i].lstrip( "-" )
-			context[entry] = eval( args["context"][i+1] )
+		for i in range( 0, len( contextArgs ), 2 ) :
+			entry = contextArgs[i].lstrip( "-" )
+			context[entry] = eval( contextArgs[i+1] )
 
-		frames = self.parameters()["frames"].getFrameListValue().asList()
 		if not frames :
 			frames = [ scriptNode.context().getFrame() ]
 
@@ -42,6 +42,7 @@
 
 #include "Gaffer/CatchingSignalCombiner.h"
 #include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedPlug.h"
 
 #include "IECore/CompoundData.h"
 #include "IECore/FrameList.h"
@@ -175,6 +176,21 @@ class GAFFERDISPATCH_API Dispatcher : public Gaffer::Node
 		/// At the start of dispatch(), a directory is created under jobsDirectoryPlug + jobNamePlug
 		/// which the dispatcher writes temporary files to. This method returns the most recent created directory.
 		const std::string jobDirectory() const;
+		/// When on, batches which were executed successfully by a previous dispatch
+		/// with the same job name are skipped, provided their task hashes and those of
+		/// all their preTasks are unchanged. Only tasks for which `TaskPlug::hashCoversInputs()`
+		/// returns true may be skipped, and tasks downstream of any others are always
+		/// executed. A record of successfully executed batches is kept in a "taskHashes"
+		/// directory alongside the numbered job directories.
+		Gaffer::BoolPlug *skipUnchangedTasksPlug();
+		const Gaffer::BoolPlug *skipUnchangedTasksPlug() const;
+		/// When greater than zero, the batch size for each node is chosen automatically
+		/// so that batches take approximately this many seconds to execute. Execution
+		/// times are recorded in a "taskTimings" directory alongside the numbered job
+		/// directories, and nodes without a recorded time use their own `batchSize`
+		/// until one is available.
+		Gaffer::FloatPlug *targetBatchDurationPlug();
+		const Gaffer::FloatPlug *targetBatchDurationPlug() const;
 		//@}
 
 		/// A function which creates a Dispatcher.
@@ -159,6 +159,11 @@ class GAFFERDISPATCH_API TaskNode : public Gaffer::DependencyNode
 				/// via a single call to `executeSequence()`, and shouldn't
 				/// be split into several distinct calls.
 				bool requiresSequenceExecution() const;
+				/// Returns true if `hash()` accounts for everything that affects
+				/// the side effects of `execute()`, so that a task with an unchanged
+				/// hash need not be executed again. Used by the Dispatcher's
+				/// `skipUnchangedTasks` option.
+				bool hashCoversInputs() const;
 
 				/// Fills tasks with all Tasks that must be completed before `execute()`
 				/// is called in the current context. Primarily for use by the Dispatcher
@@ -235,6 +240,28 @@ class GAFFERDISPATCH_API TaskNode : public Gaffer::DependencyNode
 		/// \todo Add `const TaskPlug *plug, const Context *context` arguments.
 		virtual bool requiresSequenceExecution() const;
 
+		/// Called by `TaskPlug::hashCoversInputs()`. Nodes should only return
+		/// true if `hash()` includes all the upstream inputs that affect execution,
+		/// and is stable between processes - so it mustn't include pointers or
+		/// `Context::hash()`. The default implementation returns false.
+		/// \todo Add `const TaskPlug *plug` argument.
+		virtual bool hashCoversInputs() const;
+
+		/// Utility for implementing `executeSequence()` in nodes which require
+		/// sequence execution only because their results must be committed in
+		/// frame order. The work for each frame is split into two stages :
+		/// `computeFunctor` is called in parallel for up to `maxConcurrentFrames`
+		/// frames at once, and its results are passed serially, in frame order,
+		/// to `commitFunctor`. Both functors are called with the appropriate
+		/// frame in the current context.
+		template<typename ComputeFunctor, typename CommitFunctor>
+		void parallelExecuteSequence(
+			const std::vector<float> &frames,
+			const ComputeFunctor &computeFunctor, // Signature : T computeFunctor()
+			CommitFunctor &&commitFunctor, // Signature : void commitFunctor( const T &computeFunctorResult )
+			size_t maxConcurrentFrames
+		) const;
+
 	private :
 
 		// Friendship for the bindings.
@@ -246,4 +273,6 @@ class GAFFERDISPATCH_API TaskNode : public Gaffer::DependencyNode
 
 } // namespace GafferDispatch
 
+#include "GafferDispatch/TaskNode.inl"
+
 #endif // GAFFERDISPATCH_TASKNODE_H
@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERDISPATCH_TASKNODE_INL
+#define GAFFERDISPATCH_TASKNODE_INL
+
+#include "Gaffer/Context.h"
+
+#include "tbb/pipeline.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace GafferDispatch
+{
+
+template<typename ComputeFunctor, typename CommitFunctor>
+void TaskNode::parallelExecuteSequence( const std::vector<float> &frames, const ComputeFunctor &computeFunctor, CommitFunctor &&commitFunctor, size_t maxConcurrentFrames ) const
+{
+	typedef typename std::result_of<ComputeFunctor()>::type ComputeFunctorResult;
+	typedef std::pair<float, ComputeFunctorResult> FrameFilterResult;
+
+	std::vector<float>::const_iterator frameIt = frames.begin();
+	const Gaffer::Context *context = Gaffer::Context::current();
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_pipeline( std::max<size_t>( maxConcurrentFrames, 1 ),
+
+		tbb::make_filter<void, float>(
+			tbb::filter::serial_in_order,
+			[ &frameIt, &frames ] ( tbb::flow_control &fc ) -> float {
+				if( frameIt == frames.end() )
+				{
+					fc.stop();
+					return 0.0f;
+				}
+				return *frameIt++;
+			}
+		) &
+
+		tbb::make_filter<float, FrameFilterResult>(
+
+			tbb::filter::parallel,
+
+			[ &computeFunctor, context ] ( float frame ) {
+
+				Gaffer::Context::EditableScope frameScope( context );
+				frameScope.setFrame( frame );
+
+				return FrameFilterResult( frame, computeFunctor() );
+			}
+
+		) &
+
+		tbb::make_filter<FrameFilterResult, void>(
+
+			tbb::filter::serial_in_order,
+
+			[ &commitFunctor, context ] ( const FrameFilterResult &input ) {
+
+				Gaffer::Context::EditableScope frameScope( context );
+				frameScope.setFrame( input.first );
+
+				commitFunctor( input.second );
+
+			}
+
+		),
+
+		// Prevents outer tasks silently cancelling our tasks
+		taskGroupContext
+
+	);
+}
+
+} // namespace GafferDispatch
+
+#endif // GAFFERDISPATCH_TASKNODE_INL
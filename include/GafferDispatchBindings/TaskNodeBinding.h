@@ -243,6 +243,27 @@ class TaskNodeWrapper : public GafferBindings::DependencyNodeWrapper<WrappedType
 			return WrappedType::requiresSequenceExecution();
 		}
 
+		bool hashCoversInputs() const override
+		{
+			if( this->isSubclassed() )
+			{
+				IECorePython::ScopedGILLock gilLock;
+				try
+				{
+					boost::python::object f = this->methodOverride( "hashCoversInputs" );
+					if( f )
+					{
+						return f();
+					}
+				}
+				catch( const boost::python::error_already_set &e )
+				{
+					IECorePython::ExceptionAlgo::translatePythonException();
+				}
+			}
+			return WrappedType::hashCoversInputs();
+		}
+
 };
 
 } // namespace GafferDispatchBindings
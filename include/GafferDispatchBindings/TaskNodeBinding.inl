@@ -110,6 +110,12 @@ static bool requiresSequenceExecution( T &n )
 	return n.T::requiresSequenceExecution();
 }
 
+template<typename T>
+static bool hashCoversInputs( T &n )
+{
+	return n.T::hashCoversInputs();
+}
+
 };
 
 } // namespace Detail
@@ -125,6 +131,7 @@ TaskNodeClass<T, Ptr>::TaskNodeClass( const char *docString )
 	this->def( "execute", &Detail::TaskNodeAccessor::execute<T> );
 	this->def( "executeSequence", &Detail::TaskNodeAccessor::executeSequence<T> );
 	this->def( "requiresSequenceExecution", &Detail::TaskNodeAccessor::requiresSequenceExecution<T> );
+	this->def( "hashCoversInputs", &Detail::TaskNodeAccessor::hashCoversInputs<T> );
 }
 
 } // namespace GafferDispatchBindings
@@ -84,6 +84,12 @@ class GAFFERIMAGE_API Catalogue : public ImageNode
 				static Ptr load( const std::string &fileName );
 				void save( const std::string &fileName ) const;
 
+				/// Returns the number of bytes used to hold the image in
+				/// memory, not counting the compute cache. Images received
+				/// from renders are compressed losslessly while they are not
+				/// being viewed, and images loaded from disk use none.
+				size_t memoryUsage() const;
+
 				Gaffer::PlugPtr createCounterpart( const std::string &name, Direction direction ) const override;
 
 		};
@@ -108,6 +114,12 @@ class GAFFERIMAGE_API Catalogue : public ImageNode
 		/// set to match `Catalogue::displayDriverServer()->portNumber()`.
 		static IECoreImage::DisplayDriverServer *displayDriverServer();
 
+		/// Images received from renders are saved to disk on a
+		/// background thread. This blocks until all pending saves
+		/// have completed, and is called automatically when the
+		/// GafferImage Python module exits.
+		static void waitForSaves();
+
 		/// Generates a filename that could be used for storing
 		/// a particular image locally in this Catalogue's directory.
 		/// Primarily exists to be used in the UI.
@@ -137,6 +149,10 @@ class GAFFERIMAGE_API Catalogue : public ImageNode
 		void driverCreated( IECoreImage::DisplayDriver *driver, const IECore::CompoundData *parameters );
 		void imageReceived( Gaffer::Plug *plug );
 
+		void plugSet( Gaffer::Plug *plug );
+		void prioritiseActiveImage();
+		void compressInactiveImages();
+
 		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
 
@@ -60,6 +60,7 @@ class GAFFERIMAGE_API ColorProcessor : public ImageProcessor
 		const Gaffer::StringPlug *channelsPlug() const;
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
+		bool supportsMipLevels() const override;
 
 	protected :
 
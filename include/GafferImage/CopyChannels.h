@@ -58,6 +58,7 @@ class GAFFERIMAGE_API CopyChannels : public ImageProcessor
 		const Gaffer::StringPlug *channelsPlug() const;
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
+		bool supportsMipLevels() const override;
 
 	protected :
 
@@ -72,6 +72,7 @@ class GAFFERIMAGE_API DeleteChannels : public ImageProcessor
 		//@}
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
+		bool supportsMipLevels() const override;
 
 	protected :
 
@@ -76,6 +76,11 @@ class GAFFERIMAGE_API Display : public ImageNode
 		/// Emitted when a complete image has been received.
 		static UnaryPlugSignal &imageReceivedSignal();
 
+		/// Data received by the driver is batched up, and Display nodes
+		/// are updated at most once per interval. Defaults to 0.05 seconds.
+		static void setUpdateInterval( float seconds );
+		static float getUpdateInterval();
+
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
 	protected :
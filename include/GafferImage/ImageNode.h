@@ -91,6 +91,26 @@ class GAFFERIMAGE_API ImageNode : public Gaffer::ComputeNode
 		/// \deprecated remove this once all derived classes stop using it.
 		virtual bool enabled() const;
 
+		/// May be implemented to return true by derived classes which compute
+		/// their output directly at the reduced resolution requested via
+		/// `ImagePlug::mipLevelContextName`. This is typically trivial for nodes
+		/// which process each pixel independently, since they need only pass
+		/// the context through to their inputs. For all other nodes, the output
+		/// is computed at full resolution and then box filtered to the requested
+		/// level, which is exact but provides no speedup. The default
+		/// implementation returns false.
+		///
+		/// Note that a per-pixel node which opts in computes `f( average( in ) )`
+		/// rather than `average( f( in ) )`. These are only equal when `f` is
+		/// linear (or affine) in the pixel values, as it is for channel copies
+		/// and simple additions. For other nodes, such as colour space
+		/// conversions, gamma, clamping, and merges or mixes weighted by alpha,
+		/// the result is an approximation. This approximation is accepted
+		/// deliberately, since mip levels exist to provide fast previews in the
+		/// Viewer. Nodes whose output would be misleading rather than merely
+		/// approximate should not opt in.
+		virtual bool supportsMipLevels() const;
+
 		/// Implemented to call the hash*() methods below whenever output is part of an ImagePlug.
 		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		/// Hash methods for the individual children of outPlug(). A derived class must either :
@@ -127,6 +147,11 @@ class GAFFERIMAGE_API ImageNode : public Gaffer::ComputeNode
 
 	private :
 
+		// Used to provide reduced resolution images for nodes which
+		// don't support mip levels themselves.
+		void hashMipLevel( const ImagePlug *parent, const Gaffer::ValuePlug *output, int mipLevel, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		void computeMipLevel( const ImagePlug *parent, Gaffer::ValuePlug *output, int mipLevel, const Gaffer::Context *context ) const;
+
 		static size_t g_firstPlugIndex;
 };
 
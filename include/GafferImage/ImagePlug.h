@@ -116,6 +116,20 @@ class GAFFERIMAGE_API ImagePlug : public Gaffer::ValuePlug
 		/// InternedStrings on every lookup.
 		static const IECore::InternedString channelNameContextName;
 		static const IECore::InternedString tileOriginContextName;
+		/// The name used to request a reduced resolution version of
+		/// the image via a Context object. When this is set to an int
+		/// greater than 0, the image is reduced in size by a factor of
+		/// `2^mipLevel` in each dimension, with the format, data window
+		/// and channel data all expressed in the reduced pixel space.
+		/// This allows viewers to request only the resolution they are
+		/// able to display. Reduced images are intended for display
+		/// only : nodes which are nonlinear per pixel may compute them
+		/// approximately, so they are not guaranteed to match a box
+		/// filtered version of the full resolution image. See
+		/// ImageNode::supportsMipLevels() for details. Nodes which compute
+		/// values other than images, such as the ImageSampler, must remove
+		/// this variable before evaluating their input image.
+		static const IECore::InternedString mipLevelContextName;
 
 		/// @name Convenience accessors
 		/// These functions create temporary Contexts specifying image:channelName
@@ -127,6 +141,15 @@ class GAFFERIMAGE_API ImagePlug : public Gaffer::ValuePlug
 		//@{
 		IECore::ConstFloatVectorDataPtr channelData( const std::string &channelName, const Imath::V2i &tileOrigin ) const;
 		IECore::MurmurHash channelDataHash( const std::string &channelName, const Imath::V2i &tileOrigin ) const;
+		/// Returns the data for several channels of the same tile, in the
+		/// order they were requested. This is more efficient than
+		/// making a call per channel, because the temporary Context and
+		/// the lookup of the channel names are shared between all channels.
+		/// Channels which don't exist in the image are returned as `blackTile()`.
+		std::vector<IECore::ConstFloatVectorDataPtr> channelData( const std::vector<std::string> &channelNames, const Imath::V2i &tileOrigin ) const;
+		/// Appends the hash for each of the channels returned by the function
+		/// above to `h`.
+		void channelDataHash( const std::vector<std::string> &channelNames, const Imath::V2i &tileOrigin, IECore::MurmurHash &h ) const;
 		/// Returns a pointer to an IECore::ImagePrimitive. Note that the image's
 		/// coordinate system will be converted to the OpenEXR and Cortex specification
 		/// and have it's origin in the top left of it's display window with the positive
@@ -90,6 +90,19 @@ class GAFFERIMAGE_API ImageStats : public Gaffer::ComputeNode
 
 		std::string channelName( int colorIndex ) const;
 
+		// Stores the min, max and sum of a single channel for the part of the
+		// area that lies within the current tile, as specified by the
+		// "image:channelName" and "image:tileOrigin" context variables. Because
+		// tiles entirely within the area don't depend on the area itself, only
+		// the edge tiles need recomputing when the area is adjusted.
+		Gaffer::ObjectPlug *tileStatsPlug();
+		const Gaffer::ObjectPlug *tileStatsPlug() const;
+
+		// Stores the min, max and average of a single channel for the whole
+		// area, reduced in parallel from the results of tileStatsPlug().
+		Gaffer::ObjectPlug *allStatsPlug();
+		const Gaffer::ObjectPlug *allStatsPlug() const;
+
 		static size_t g_firstPlugIndex;
 
 };
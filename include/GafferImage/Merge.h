@@ -88,6 +88,7 @@ class GAFFERIMAGE_API Merge : public ImageProcessor
 		const Gaffer::IntPlug *operationPlug() const;
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
+		bool supportsMipLevels() const override;
 
 	protected :
 
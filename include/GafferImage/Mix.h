@@ -70,6 +70,7 @@ class GAFFERIMAGE_API Mix : public ImageProcessor
 
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
+		bool supportsMipLevels() const override;
 
 	protected :
 
@@ -98,6 +98,15 @@ class GAFFERIMAGE_API RankFilter : public ImageProcessor
 		Gaffer::V2iVectorDataPlug *pixelOffsetsPlug();
 		const Gaffer::V2iVectorDataPlug *pixelOffsetsPlug() const;
 
+		// Erode and Dilate are separable, so when no master channel is set we
+		// filter horizontally onto this private plug, and then filter that
+		// vertically to produce the output. This means that the horizontal
+		// pass is cached and shared by all the output tiles that need it.
+		ImagePlug *horizontalPassPlug();
+		const ImagePlug *horizontalPassPlug() const;
+
+		bool separable() const;
+
 		static size_t g_firstPlugIndex;
 		int m_mode;
 };
@@ -41,6 +41,7 @@
 
 #include "Gaffer/CompoundNumericPlug.h"
 #include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 namespace Gaffer
 {
@@ -96,9 +97,13 @@ class GAFFERIMAGE_API Resample : public ImageProcessor
 		const Gaffer::IntPlug *debugPlug() const;
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
+		bool supportsMipLevels() const override;
 
 	protected :
 
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+
 		void hashDataWindow( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		void hashChannelData( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 
@@ -110,6 +115,17 @@ class GAFFERIMAGE_API Resample : public ImageProcessor
 		ImagePlug *horizontalPassPlug();
 		const ImagePlug *horizontalPassPlug() const;
 
+		// The filter weights for the horizontal and vertical passes
+		// depend only on the tile's x and y origin respectively, so
+		// we compute them on these plugs, where they are cached and
+		// shared by all tiles in the same column or row, and by all
+		// channels.
+		Gaffer::FloatVectorDataPlug *horizontalWeightsPlug();
+		const Gaffer::FloatVectorDataPlug *horizontalWeightsPlug() const;
+
+		Gaffer::FloatVectorDataPlug *verticalWeightsPlug();
+		const Gaffer::FloatVectorDataPlug *verticalWeightsPlug() const;
+
 		static size_t g_firstPlugIndex;
 
 };
@@ -93,6 +93,7 @@ class GAFFERIMAGE_API Shuffle : public ImageProcessor
 		const Gaffer::ValuePlug *channelsPlug() const;
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
+		bool supportsMipLevels() const override;
 
 	protected :
 
@@ -56,13 +56,7 @@
 #include <array>
 
 #include <chrono>
-
-namespace IECoreGL
-{
-
-IE_CORE_FORWARDDECLARE( Texture )
-
-} // namespace IECoreGL
+#include <memory>
 
 namespace Gaffer
 {
@@ -199,20 +193,25 @@ class GAFFERIMAGEUI_API ImageGadget : public GafferUI::Gadget
 
 		struct TileIndex
 		{
-			TileIndex( const Imath::V2i &tileOrigin, IECore::InternedString channelName )
-				:	tileOrigin( tileOrigin ), channelName( channelName )
+			TileIndex( const Imath::V2i &tileOrigin, IECore::InternedString channelName, int mipLevel )
+				:	tileOrigin( tileOrigin ), channelName( channelName ), mipLevel( mipLevel )
 			{
 			}
 
 			bool operator == ( const TileIndex &rhs ) const
 			{
-				return tileOrigin == rhs.tileOrigin && channelName == rhs.channelName;
+				return tileOrigin == rhs.tileOrigin && channelName == rhs.channelName && mipLevel == rhs.mipLevel;
 			}
 
 			Imath::V2i tileOrigin;
 			IECore::InternedString channelName;
+			int mipLevel;
 		};
 
+		// Tiles are packed into large shared textures, so that we
+		// don't need to allocate and bind a texture per tile.
+		struct AtlasSlot;
+
 		struct Tile
 		{
 
@@ -233,14 +232,15 @@ class GAFFERIMAGEUI_API ImageGadget : public GafferUI::Gadget
 			// such that they become visible to the UI thread together.
 			static void applyUpdates( const std::vector<Update> &updates );
 
-			// Called from the UI thread.
-			const IECoreGL::Texture *texture( bool &active );
+			// Called from the UI thread. Uploads any pending
+			// update into the tile's slot in the texture atlas.
+			const AtlasSlot *atlasSlot( bool &active );
 
 			private :
 
 				IECore::MurmurHash m_channelDataHash;
 				IECore::ConstFloatVectorDataPtr m_channelDataToConvert;
-				IECoreGL::TexturePtr m_texture;
+				std::shared_ptr<AtlasSlot> m_atlasSlot;
 				bool m_active;
 				std::chrono::steady_clock::time_point m_activeStartTime;
 				typedef tbb::spin_mutex Mutex;
@@ -256,9 +256,25 @@ class GAFFERIMAGEUI_API ImageGadget : public GafferUI::Gadget
 		// Tile update. We update tiles asynchronously from background
 		// threads.
 
+		void updateMipLevel();
 		void updateTiles();
 		void removeOutOfBoundsTiles() const;
 
+		// When zoomed out, we request a reduced resolution image via
+		// the `image:mipLevel` context variable, so that we don't compute
+		// and upload more pixels than can be displayed. The mip level and
+		// data window for the tiles being displayed are stored separately,
+		// because they lag behind `m_mipLevel` while tiles are updated.
+		int m_mipLevel;
+		int m_tilesMipLevel;
+		Imath::Box2i m_tilesDataWindow;
+		// When the mip level changes, we keep the tiles from the last
+		// complete level, and draw them in place of any tiles which haven't
+		// been computed yet for the new level. A level of -1 means there
+		// are no fallback tiles.
+		int m_fallbackMipLevel;
+		Imath::Box2i m_fallbackDataWindow;
+
 		std::unique_ptr<Gaffer::BackgroundTask> m_tilesTask;
 		std::atomic_bool m_renderRequestPending;
 
@@ -42,6 +42,7 @@
 
 #include "GafferDispatch/TaskNode.h"
 
+#include "Gaffer/NumericPlug.h"
 #include "Gaffer/TypedPlug.h"
 #include "Gaffer/StringPlug.h"
 
@@ -69,6 +70,13 @@ class GAFFERSCENE_API SceneWriter : public GafferDispatch::TaskNode
 		ScenePlug *outPlug();
 		const ScenePlug *outPlug() const;
 
+		/// The number of frames computed at once by `executeSequence()`.
+		/// Frames are still written in order, but the data for an entire
+		/// scene is held in memory for each frame in flight. A value of 1
+		/// writes each location as soon as it has been computed.
+		Gaffer::IntPlug *concurrentFramesPlug();
+		const Gaffer::IntPlug *concurrentFramesPlug() const;
+
 		IECore::MurmurHash hash( const Gaffer::Context *context ) const override;
 
 		void execute() const override;
@@ -37,11 +37,15 @@
 import os
 import errno
 import signal
+import multiprocessing
 import shlex
 import subprocess32 as subprocess
+import tempfile
 import threading
 import time
 import traceback
+import json
+import Queue
 
 import IECore
 
@@ -57,6 +61,12 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 		self["executeInBackground"] = Gaffer.BoolPlug( defaultValue = False )
 		self["ignoreScriptLoadErrors"] = Gaffer.BoolPlug( defaultValue = False )
 		self["environmentCommand"] = Gaffer.StringPlug()
+		self["maxConcurrentTasks"] = Gaffer.IntPlug( defaultValue = 1, minValue = 1 )
+		self["concurrentForegroundTasks"] = Gaffer.BoolPlug( defaultValue = False )
+		self["useWorkers"] = Gaffer.BoolPlug( defaultValue = False )
+		self["maxThreads"] = Gaffer.IntPlug( defaultValue = 0, minValue = 0 )
+		self["maxMemory"] = Gaffer.FloatPlug( defaultValue = 0, minValue = 0 )
+		self["recordTelemetry"] = Gaffer.BoolPlug( defaultValue = False )
 
 		self.__jobPool = jobPool if jobPool else LocalDispatcher.defaultJobPool()
 
@@ -91,6 +101,26 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 			self.__environmentCommand = Gaffer.Context.current().substitute(
 				dispatcher["environmentCommand"].getValue()
 			)
+			self.__maxConcurrentTasks = dispatcher["maxConcurrentTasks"].getValue()
+			self.__concurrentForegroundTasks = dispatcher["concurrentForegroundTasks"].getValue()
+			self.__useWorkers = dispatcher["useWorkers"].getValue()
+			self.__maxThreads = dispatcher["maxThreads"].getValue() or multiprocessing.cpu_count()
+			self.__maxMemory = dispatcher["maxMemory"].getValue()
+			# Records of each executed batch, written to
+			# "timeline.json" in the job directory when the
+			# job finishes.
+			self.__recordTelemetry = dispatcher["recordTelemetry"].getValue()
+			self.__timeline = []
+			self.__numReports = 0
+			# Persistent `gaffer execute -worker` processes, and the
+			# subset of them which are waiting for work.
+			self.__workers = []
+			self.__idleWorkers = []
+			self.__workersMutex = threading.Lock()
+			# Maps from batch to the process executing it, for
+			# all batches currently running in the background.
+			self.__processes = {}
+			self.__processesMutex = threading.Lock()
 
 			self.__messageHandler = IECore.CapturingMessageHandler()
 			self.__messageTitle = "%s : Job %s %s" % ( self.__dispatcher.getName(), self.__name, self.__id )
@@ -148,6 +178,10 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 				"rss" : rss,
 			}
 
+		def timeline( self ) :
+
+			return list( self.__timeline )
+
 		def messageHandler( self ) :
 
 			return self.__messageHandler
@@ -158,8 +192,14 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 				threading.Thread( target = self.__backgroundDispatch ).start()
 			else :
 				with self.__messageHandler :
-					self.__foregroundDispatch( self.__batch )
-					self.__reportCompleted( self.__batch )
+					if self.__concurrentForegroundTasks and self.__maxConcurrentTasks > 1 :
+						# Batches execute on threads within this process, so
+						# this is only safe when the tasks' `execute()` methods
+						# are thread-safe, which is why it is opt-in.
+						self.__scheduleBatches( self.__batch, self.__launchBatchInThread )
+					else :
+						self.__foregroundDispatch( self.__batch )
+						self.__reportCompleted( self.__batch )
 
 		def failed( self ) :
 
@@ -170,6 +210,12 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 			if not self.failed() :
 				self.__killBatchWalk( self.__batch )
 
+			with self.__processesMutex :
+				processes = self.__processes.values()
+
+			for process in processes :
+				self.__killProcess( process )
+
 		def killed( self ) :
 
 			return "killed" in self.__batch.blindData().keys()
@@ -212,52 +258,162 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 			description = "executing %s on %s" % ( batch.blindData()["nodeName"].value, str(batch.frames()) )
 			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, description )
 
+			startTime = time.time()
 			try :
 				self.__setStatus( batch, LocalDispatcher.Job.Status.Running )
 				batch.execute()
 			except Exception as e :
 				IECore.msg( IECore.MessageHandler.Level.Debug, self.__messageTitle, traceback.format_exc() )
+				self.__recordTimelineEntry( batch, startTime, "Failed" )
 				self.__reportFailed( batch )
 				raise e
 
 			self.__setStatus( batch, LocalDispatcher.Job.Status.Complete )
+			self.__recordTimelineEntry( batch, startTime, "Complete" )
 
 			return True
 
 		def __backgroundDispatch( self ) :
 
 			with self.__messageHandler :
-				self.__doBackgroundDispatch( self.__batch )
+				try :
+					self.__scheduleBatches( self.__batch, self.__launchBatch )
+				finally :
+					self.__stopWorkers()
+
+		def __scheduleBatches( self, batch, launch ) :
+
+			# We schedule batches as soon as all their preTasks have
+			# completed, running up to `maxConcurrentTasks` of them at
+			# once. The `launch` function starts a batch running, and
+			# must put `( batch, error )` on the `completed` queue when
+			# it finishes, where `error` is a non-zero return code or an
+			# exception if the batch failed.
+
+			batches = self.__batchesInExecutionOrder( batch )
+			completed = Queue.Queue()
+			running = set()
+			startTimes = {}
+			usedThreads = 0
+			usedMemory = 0
+			failedBatch = None
+			failedError = None
+
+			while True :
+
+				scheduled = True
+				while scheduled and failedBatch is None and not self.killed() :
+
+					scheduled = False
+					for b in batches :
+
+						if len( running ) >= self.__maxConcurrentTasks :
+							break
+
+						if not self.__ready( b ) :
+							continue
+
+						if not b.plug() :
+							# The root batch only exists to depend on the others,
+							# so if it is ready, then we're done.
+							self.__reportCompleted( b )
+							return True
+
+						if len( b.frames() ) == 0 :
+							# This case occurs for nodes like TaskList and TaskContextProcessors,
+							# because they don't do anything in execute (they have empty hashes).
+							# Their batches exist only to depend on upstream batches. We don't need
+							# to do any work here, but we still signal completion for the task to
+							# provide progress feedback to the user.
+							self.__setStatus( b, LocalDispatcher.Job.Status.Complete )
+							IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Finished " + b.blindData()["nodeName"].value )
+						else :
+							# Pack batches according to their declared resource
+							# requirements, although we always allow a single batch
+							# to run even if it exceeds the limits on its own.
+							threads, memory = self.__resources( b )
+							if running and (
+								usedThreads + threads > self.__maxThreads or
+								( self.__maxMemory and usedMemory + memory > self.__maxMemory )
+							) :
+								continue
+							launch( b, completed )
+							running.add( b )
+							startTimes[b] = time.time()
+							usedThreads += threads
+							usedMemory += memory
+
+						scheduled = True
+
+				if not running :
+					if failedBatch is not None :
+						self.__reportFailed( failedBatch )
+						if isinstance( failedError, Exception ) :
+							raise failedError
+					else :
+						self.__reportKilled( batch )
+					return False
 
-		def __doBackgroundDispatch( self, batch ) :
+				b, error = completed.get()
+				running.remove( b )
+				startTime = startTimes.pop( b )
+				duration = time.time() - startTime
+				threads, memory = self.__resources( b )
+				usedThreads -= threads
+				usedMemory -= memory
+				with self.__processesMutex :
+					self.__processes.pop( b, None )
+
+				if b.blindData().get( "killed" ) :
+					self.__setStatus( b, LocalDispatcher.Job.Status.Killed )
+					self.__recordTimelineEntry( b, startTime, "Killed" )
+				elif error :
+					# Allow any other running batches to finish before
+					# reporting the failure, but don't launch any more.
+					self.__setStatus( b, LocalDispatcher.Job.Status.Failed )
+					self.__recordTimelineEntry( b, startTime, "Failed" )
+					if failedBatch is None :
+						failedBatch = b
+						failedError = error
+				else :
+					self.__setStatus( b, LocalDispatcher.Job.Status.Complete )
+					self.__recordTimelineEntry( b, startTime, "Complete" )
+					hashFile = b.blindData().get( "dispatcher:hashFile" )
+					if hashFile is not None :
+						# Record the successful execution for `skipUnchangedTasks`,
+						# as `TaskBatch.execute()` does for in-process execution.
+						open( hashFile.value, "w" ).close()
+					timingFile = b.blindData().get( "dispatcher:timingFile" )
+					if timingFile is not None and launch != self.__launchBatchInThread :
+						# Record the time taken per frame for `targetBatchDuration`,
+						# as `TaskBatch.execute()` does for in-process execution.
+						# This includes process startup and script loading, which
+						# is exactly the overhead that larger batches amortise.
+						# Batches for the same node may finish concurrently, so we
+						# write to a temporary file and rename it, to ensure that
+						# readers never see a partially written file.
+						fd, tempFileName = tempfile.mkstemp( dir = os.path.dirname( timingFile.value ), prefix = os.path.basename( timingFile.value ) + "." )
+						with os.fdopen( fd, "w" ) as f :
+							f.write( str( duration / len( b.frames() ) ) )
+						os.rename( tempFileName, timingFile.value )
+
+		def __launchBatch( self, batch, completed ) :
 
-			if self.__getStatus( batch ) == LocalDispatcher.Job.Status.Complete :
-				return True
-
-			for upstreamBatch in batch.preTasks() :
-				if not self.__doBackgroundDispatch( upstreamBatch ) :
-					return False
+			taskContext = batch.context()
+			frames = str( IECore.frameListFromList( [ int(x) for x in batch.frames() ] ) )
 
-			if batch.blindData().get( "killed" ) :
-				self.__reportKilled( batch )
-				return False
+			contextArgs = []
+			for entry in [ k for k in taskContext.keys() if k != "frame" and not k.startswith( "ui:" ) ] :
+				if entry not in self.__context.keys() or taskContext[entry] != self.__context[entry] :
+					contextArgs.extend( [ "-" + entry, IECore.repr( taskContext[entry] ) ] )
 
-			if not batch.plug() :
-				self.__reportCompleted( batch )
-				return True
+			self.__setStatus( batch, LocalDispatcher.Job.Status.Running )
 
-			if len( batch.frames() ) == 0 :
-				# This case occurs for nodes like TaskList and TaskContextProcessors,
-				# because they don't do anything in execute (they have empty hashes).
-				# Their batches exist only to depend on upstream batches. We don't need
-				# to do any work here, but we still signal completion for the task to
-				# provide progress feedback to the user.
-				self.__setStatus( batch, LocalDispatcher.Job.Status.Complete )
-				IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Finished " + batch.blindData()["nodeName"].value )
-				return True
+			reportFile = self.__reportFile( batch )
 
-			taskContext = batch.context()
-			frames = str( IECore.frameListFromList( [ int(x) for x in batch.frames() ] ) )
+			if self.__useWorkers :
+				self.__launchBatchOnWorker( batch, frames, contextArgs, reportFile, completed )
+				return
 
 			args = [
 				"gaffer", "execute",
@@ -271,36 +427,229 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 			if self.__ignoreScriptLoadErrors :
 				args.append( "-ignoreScriptLoadErrors" )
 
-			contextArgs = []
-			for entry in [ k for k in taskContext.keys() if k != "frame" and not k.startswith( "ui:" ) ] :
-				if entry not in self.__context.keys() or taskContext[entry] != self.__context[entry] :
-					contextArgs.extend( [ "-" + entry, IECore.repr( taskContext[entry] ) ] )
+			threads = batch.blindData()["threads"].value
+			if threads :
+				args.extend( [ "-threads", str( threads ) ] )
+
+			if reportFile :
+				args.extend( [ "-report", reportFile ] )
 
 			if contextArgs :
 				args.extend( [ "-context" ] + contextArgs )
 
-			self.__setStatus( batch, LocalDispatcher.Job.Status.Running )
 			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, " ".join( args ) )
 			process = subprocess.Popen( args, start_new_session=True )
+			self.__registerProcess( batch, process )
+
+			def waitForProcess() :
+				process.wait()
+				completed.put( ( batch, process.returncode ) )
+
+			threading.Thread( target = waitForProcess ).start()
+
+		def __launchBatchInThread( self, batch, completed ) :
+
+			# TaskBatch.execute() releases the GIL and scopes the batch's
+			# own context, so batches run concurrently on separate threads
+			# while sharing this process's compute cache.
+
+			description = "executing %s on %s" % ( batch.blindData()["nodeName"].value, str(batch.frames()) )
+			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, description )
+			self.__setStatus( batch, LocalDispatcher.Job.Status.Running )
+
+			def executeBatch() :
+
+				with self.__messageHandler :
+					try :
+						batch.execute()
+					except Exception as e :
+						IECore.msg( IECore.MessageHandler.Level.Debug, self.__messageTitle, traceback.format_exc() )
+						completed.put( ( batch, e ) )
+					else :
+						completed.put( ( batch, None ) )
+
+			threading.Thread( target = executeBatch ).start()
+
+		def __launchBatchOnWorker( self, batch, frames, contextArgs, reportFile, completed ) :
+
+			request = json.dumps( {
+				"nodes" : [ batch.blindData()["nodeName"].value ],
+				"frames" : frames,
+				"context" : contextArgs,
+				"report" : reportFile,
+			} )
+
+			worker = self.__acquireWorker()
+			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Worker %d : %s" % ( worker.pid, request ) )
+			self.__registerProcess( batch, worker )
+
+			def waitForWorker() :
+
+				try :
+					worker.stdin.write( request + "\n" )
+					worker.stdin.flush()
+					response = worker.stdout.readline()
+				except IOError :
+					response = ""
+
+				if response :
+					with self.__workersMutex :
+						self.__idleWorkers.append( worker )
+					completed.put( ( batch, int( response ) ) )
+				else :
+					# The worker died, either because it failed to
+					# load the script or because it was killed.
+					worker.wait()
+					completed.put( ( batch, worker.returncode or 1 ) )
+
+			threading.Thread( target = waitForWorker ).start()
+
+		def __acquireWorker( self ) :
+
+			with self.__workersMutex :
+				if self.__idleWorkers :
+					return self.__idleWorkers.pop()
+
+			args = shlex.split( self.__environmentCommand ) + [
+				"gaffer", "execute",
+				"-script", self.__scriptFile,
+				"-worker",
+			]
+
+			if self.__ignoreScriptLoadErrors :
+				args.append( "-ignoreScriptLoadErrors" )
+
+			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, " ".join( args ) )
+			worker = subprocess.Popen( args, stdin = subprocess.PIPE, stdout = subprocess.PIPE, start_new_session = True )
+			with self.__workersMutex :
+				self.__workers.append( worker )
+
+			return worker
+
+		def __stopWorkers( self ) :
+
+			with self.__workersMutex :
+				workers = self.__workers
+				self.__workers = []
+				self.__idleWorkers = []
+
+			for worker in workers :
+				# Closing stdin tells the worker there is no more work.
+				try :
+					worker.stdin.close()
+				except IOError :
+					pass
+				worker.wait()
+
+		def __registerProcess( self, batch, process ) :
+
 			batch.blindData()["pid"] = IECore.IntData( process.pid )
 
-			while process.poll() is None :
+			with self.__processesMutex :
+				self.__processes[batch] = process
 
-				if batch.blindData().get( "killed" ) :
-					os.killpg( process.pid, signal.SIGTERM )
-					self.__reportKilled( batch )
-					return False
+			if batch.blindData().get( "killed" ) :
+				# We were killed while launching, and `kill()`
+				# may not have seen the process.
+				self.__killProcess( process )
 
-				time.sleep( 0.01 )
+		def __killProcess( self, process ) :
 
-			if process.returncode :
-				self.__reportFailed( batch )
+			try :
+				os.killpg( process.pid, signal.SIGTERM )
+			except OSError as e :
+				# The process may have already exited.
+				if e.errno != errno.ESRCH :
+					raise
+
+		def __reportFile( self, batch ) :
+
+			# Returns the file `gaffer execute` should write its
+			# execution report to, or "" if telemetry is not required.
+
+			if not self.__recordTelemetry :
+				return ""
+
+			reportsDirectory = os.path.join( self.__directory, "reports" )
+			if not os.path.isdir( reportsDirectory ) :
+				os.makedirs( reportsDirectory )
+
+			reportFile = os.path.join( reportsDirectory, "%s.%d.json" % ( batch.blindData()["nodeName"].value, self.__numReports ) )
+			self.__numReports += 1
+			batch.blindData()["reportFile"] = IECore.StringData( reportFile )
+			return reportFile
+
+		def __recordTimelineEntry( self, batch, startTime, status ) :
+
+			if not self.__recordTelemetry :
+				return
+
+			entry = {
+				"node" : batch.blindData()["nodeName"].value,
+				"frames" : list( batch.frames() ),
+				"startTime" : startTime,
+				"endTime" : time.time(),
+				"status" : status,
+			}
+
+			reportFile = batch.blindData().get( "reportFile" )
+			if reportFile is not None and os.path.exists( reportFile.value ) :
+				with open( reportFile.value ) as f :
+					entry["report"] = json.load( f )
+
+			self.__timeline.append( entry )
+
+		def __writeTimeline( self ) :
+
+			if not self.__recordTelemetry :
+				return
+
+			with open( os.path.join( self.__directory, "timeline.json" ), "w" ) as f :
+				json.dump(
+					{
+						"name" : self.__name,
+						"id" : self.__id,
+						"batches" : sorted( self.__timeline, key = lambda e : e["startTime"] ),
+					},
+					f, indent = 4, sort_keys = True
+				)
+
+		def __resources( self, batch ) :
+
+			# Batches which don't declare requirements have them
+			# reported as 0, and are limited only by `maxConcurrentTasks`.
+			return (
+				min( batch.blindData()["threads"].value, self.__maxThreads ),
+				batch.blindData()["memory"].value
+			)
+
+		def __ready( self, batch ) :
+
+			if self.__getStatus( batch ) != LocalDispatcher.Job.Status.Waiting :
 				return False
 
-			self.__setStatus( batch, LocalDispatcher.Job.Status.Complete )
+			for upstreamBatch in batch.preTasks() :
+				if self.__getStatus( upstreamBatch ) != LocalDispatcher.Job.Status.Complete :
+					return False
 
 			return True
 
+		def __batchesInExecutionOrder( self, batch, visited = None, result = None ) :
+
+			if visited is None :
+				visited = set()
+				result = []
+
+			if batch in visited :
+				return result
+
+			visited.add( batch )
+			for upstreamBatch in batch.preTasks() :
+				self.__batchesInExecutionOrder( upstreamBatch, visited, result )
+
+			result.append( batch )
+			return result
+
 		def __getStatus( self, batch ) :
 
 			return LocalDispatcher.Job.Status( batch.blindData().get( "status", IECore.IntData( int(LocalDispatcher.Job.Status.Waiting) ) ).value )
@@ -312,12 +661,14 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 		def __reportCompleted( self, batch ) :
 
 			self.__setStatus( batch, LocalDispatcher.Job.Status.Complete )
+			self.__writeTimeline()
 			self.__dispatcher.jobPool()._remove( self )
 			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Dispatched all tasks for " + self.name() )
 
 		def __reportFailed( self, batch ) :
 
 			self.__setStatus( batch, LocalDispatcher.Job.Status.Failed )
+			self.__writeTimeline()
 			self.__dispatcher.jobPool()._fail( self )
 			frames = str( IECore.frameListFromList( [ int(x) for x in batch.frames() ] ) )
 			IECore.msg( IECore.MessageHandler.Level.Error, self.__messageTitle, "Failed to execute " + batch.blindData()["nodeName"].value + " on frames " + frames )
@@ -325,6 +676,7 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 		def __reportKilled( self, batch ) :
 
 			self.__setStatus( batch, LocalDispatcher.Job.Status.Killed )
+			self.__writeTimeline()
 			self.__dispatcher.jobPool()._remove( self )
 			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Killed " + self.name() )
 
@@ -362,6 +714,22 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 				nodeName = batch.plug().node().relativeName( batch.plug().node().scriptNode() )
 			batch.blindData()["nodeName"] = nodeName
 
+			# Store the resource requirements now, because the node
+			# must not be accessed during a background dispatch.
+			threads = 0
+			memory = 0.0
+			if batch.plug() is not None and "local" in batch.plug().node()["dispatcher"] :
+				context = Gaffer.Context( batch.context() )
+				if batch.frames() :
+					context.setFrame( batch.frames()[0] )
+				with context :
+					requirements = batch.plug().node()["dispatcher"]["local"]
+					threads = requirements["threads"].getValue()
+					memory = requirements["memory"].getValue()
+
+			batch.blindData()["threads"] = IECore.IntData( threads )
+			batch.blindData()["memory"] = IECore.FloatData( memory )
+
 			self.__setStatus( batch, LocalDispatcher.Job.Status.Waiting )
 
 			for upstreamBatch in batch.preTasks() :
@@ -451,7 +819,17 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 
 		job.execute( background = self["executeInBackground"].getValue() )
 
+	@staticmethod
+	def _setupPlugs( parentPlug ) :
+
+		if "local" in parentPlug :
+			return
+
+		parentPlug["local"] = Gaffer.Plug()
+		parentPlug["local"]["threads"] = Gaffer.IntPlug( defaultValue = 0, minValue = 0 )
+		parentPlug["local"]["memory"] = Gaffer.FloatPlug( defaultValue = 0, minValue = 0 )
+
 IECore.registerRunTimeTyped( LocalDispatcher, typeName = "GafferDispatch::LocalDispatcher" )
 IECore.registerRunTimeTyped( LocalDispatcher.JobPool, typeName = "GafferDispatch::LocalDispatcher::JobPool" )
 
-GafferDispatch.Dispatcher.registerDispatcher( "Local", LocalDispatcher )
+GafferDispatch.Dispatcher.registerDispatcher( "Local", LocalDispatcher, LocalDispatcher._setupPlugs )
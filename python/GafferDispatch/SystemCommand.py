@@ -79,4 +79,9 @@ class SystemCommand( GafferDispatch.TaskNode ) :
 
 		return h
 
+	def hashCoversInputs( self ) :
+
+		# The command is entirely determined by our plugs.
+		return True
+
 IECore.registerRunTimeTyped( SystemCommand, typeName = "GafferDispatch::SystemCommand" )
@@ -1451,6 +1451,234 @@ class DispatcherTest( GafferTest.TestCase ) :
 
  		self.assertLess( time.clock() - t, timeLimit )
 
+	def testPreTasksQueriedOncePerTask( self ) :
+
+		class CountingTaskNode( GafferDispatch.TaskNode ) :
+
+			def __init__( self, name = "CountingTaskNode" ) :
+
+				GafferDispatch.TaskNode.__init__( self, name )
+
+				self.preTasksFrames = []
+
+			def preTasks( self, context ) :
+
+				self.preTasksFrames.append( context.getFrame() )
+				return GafferDispatch.TaskNode.preTasks( self, context )
+
+			def hash( self, context ) :
+
+				h = GafferDispatch.TaskNode.hash( self, context )
+				h.append( context.getFrame() )
+				return h
+
+			def execute( self ) :
+
+				pass
+
+		IECore.registerRunTimeTyped( CountingTaskNode )
+
+		# Diamond dependency, so `d` is reached via two
+		# paths for every frame.
+
+		s = Gaffer.ScriptNode()
+		s["d"] = CountingTaskNode()
+
+		s["b"] = GafferDispatchTest.LoggingTaskNode()
+		s["b"]["preTasks"][0].setInput( s["d"]["task"] )
+
+		s["c"] = GafferDispatchTest.LoggingTaskNode()
+		s["c"]["preTasks"][0].setInput( s["d"]["task"] )
+
+		s["t"] = GafferDispatch.TaskList()
+		s["t"]["preTasks"][0].setInput( s["b"]["task"] )
+		s["t"]["preTasks"][1].setInput( s["c"]["task"] )
+
+		d = self.TestDispatcher()
+		d["framesMode"].setValue( d.FramesMode.CustomRange )
+		d["frameRange"].setValue( "1-3" )
+		d.dispatch( [ s["t"] ] )
+
+		self.assertEqual( sorted( s["d"].preTasksFrames ), [ 1, 2, 3 ] )
+
+	def testSkipUnchangedTasks( self ) :
+
+		log = []
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferDispatchTest.LoggingTaskNode( log = log )
+		s["n1"]["v"] = Gaffer.IntPlug()
+		s["n2"] = GafferDispatchTest.LoggingTaskNode( log = log )
+		s["n2"]["v"] = Gaffer.IntPlug()
+		s["n2"]["preTasks"][0].setInput( s["n1"]["task"] )
+
+		dispatcher = GafferDispatch.Dispatcher.create( "testDispatcher" )
+		dispatcher["skipUnchangedTasks"].setValue( True )
+
+		# First dispatch must execute everything.
+
+		dispatcher.dispatch( [ s["n2"] ] )
+		self.assertEqual( [ l.node for l in log ], [ s["n1"], s["n2"] ] )
+
+		# Nothing has changed, so the second dispatch
+		# shouldn't execute anything.
+
+		del log[:]
+		dispatcher.dispatch( [ s["n2"] ] )
+		self.assertEqual( log, [] )
+
+		# Changing the downstream node should only execute
+		# that node.
+
+		s["n2"]["v"].setValue( 1 )
+		dispatcher.dispatch( [ s["n2"] ] )
+		self.assertEqual( [ l.node for l in log ], [ s["n2"] ] )
+
+		# Changing the upstream node should execute it and
+		# everything downstream.
+
+		del log[:]
+		s["n1"]["v"].setValue( 1 )
+		dispatcher.dispatch( [ s["n2"] ] )
+		self.assertEqual( [ l.node for l in log ], [ s["n1"], s["n2"] ] )
+
+		# And turning off skipping should execute everything
+		# regardless.
+
+		del log[:]
+		dispatcher["skipUnchangedTasks"].setValue( False )
+		dispatcher.dispatch( [ s["n2"] ] )
+		self.assertEqual( [ l.node for l in log ], [ s["n1"], s["n2"] ] )
+
+	def testTargetBatchDuration( self ) :
+
+		log = []
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferDispatchTest.LoggingTaskNode( log = log )
+		s["n1"]["f"] = Gaffer.StringPlug( defaultValue = "####" )
+		s["n1"]["dispatcher"]["batchSize"].setValue( 2 )
+
+		dispatcher = GafferDispatch.Dispatcher.create( "testDispatcher" )
+		dispatcher["framesMode"].setValue( GafferDispatch.Dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-10" )
+		dispatcher["targetBatchDuration"].setValue( 1 )
+
+		# The first dispatch has no recorded timings, so must
+		# use the batch size from the node, and record timings
+		# for the next dispatch.
+
+		dispatcher.dispatch( [ s["n1"] ] )
+		self.assertEqual( len( log ), 10 )
+
+		timingFile = os.path.join( self.temporaryDirectory(), "taskTimings", "n1" )
+		self.assertTrue( os.path.exists( timingFile ) )
+		with open( timingFile ) as f :
+			self.assertGreaterEqual( float( f.read() ), 0 )
+
+		nullDispatcher = self.NullDispatcher()
+		nullDispatcher["framesMode"].setValue( GafferDispatch.Dispatcher.FramesMode.CustomRange )
+		nullDispatcher["frameRange"].setValue( "1-10" )
+		nullDispatcher["jobsDirectory"].setValue( self.temporaryDirectory() )
+
+		def batchSizes() :
+			nullDispatcher.dispatch( [ s["n1"] ] )
+			return sorted( len( b.frames() ) for b in nullDispatcher.lastDispatch.preTasks() )
+
+		self.assertEqual( batchSizes(), [ 2 ] * 5 )
+
+		# Subsequent dispatches should size the batches
+		# to match the target duration.
+
+		nullDispatcher["targetBatchDuration"].setValue( 1 )
+		with open( timingFile, "w" ) as f :
+			f.write( "0.25" )
+		self.assertEqual( batchSizes(), [ 2, 4, 4 ] )
+
+		# Even if frames are very expensive, batches
+		# must contain at least one.
+
+		with open( timingFile, "w" ) as f :
+			f.write( "10" )
+		self.assertEqual( batchSizes(), [ 1 ] * 10 )
+
+		# Timings are written via temporary files, which
+		# must not be left behind.
+
+		self.assertEqual( os.listdir( os.path.dirname( timingFile ) ), [ "n1" ] )
+
+	def testTargetBatchDurationWithContextVaryingBatchSize( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferDispatchTest.LoggingTaskNode()
+		s["n1"]["f"] = Gaffer.StringPlug( defaultValue = "${size}.####" )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent["n1"]["dispatcher"]["batchSize"] = context.get( "size", 1 )' )
+
+		s["l"] = GafferDispatch.TaskList()
+		for size in ( 2, 5 ) :
+			v = GafferDispatch.TaskContextVariables()
+			v["preTasks"][0].setInput( s["n1"]["task"] )
+			v["variables"].addMember( "size", size )
+			s["v{}".format( size )] = v
+			s["l"]["preTasks"][len( s["l"]["preTasks"] ) - 1].setInput( v["task"] )
+
+		dispatcher = self.NullDispatcher()
+		dispatcher["framesMode"].setValue( GafferDispatch.Dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-10" )
+		dispatcher["jobsDirectory"].setValue( self.temporaryDirectory() )
+		dispatcher["targetBatchDuration"].setValue( 1 )
+		dispatcher.dispatch( [ s["l"] ] )
+
+		# The same batch may be reached via several paths, so
+		# we identify batches by their frames.
+		def n1Frames( batch, result ) :
+			for b in batch.preTasks() :
+				if b.node() is not None and b.node().isSame( s["n1"] ) :
+					result.add( tuple( b.frames() ) )
+				else :
+					n1Frames( b, result )
+			return result
+
+		# No timings have been recorded, so each context
+		# must use its own batch size.
+
+		self.assertEqual(
+			sorted( len( f ) for f in n1Frames( dispatcher.lastDispatch, set() ) ),
+			[ 2 ] * 5 + [ 5 ] * 2
+		)
+
+	def testSkipUnchangedTasksRequiresHashCoveringInputs( self ) :
+
+		class IncompleteHashTaskNode( GafferDispatchTest.LoggingTaskNode ) :
+
+			def hashCoversInputs( self ) :
+
+				return False
+
+		log = []
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferDispatchTest.LoggingTaskNode( log = log )
+		s["n2"] = IncompleteHashTaskNode( log = log )
+		s["n2"]["preTasks"][0].setInput( s["n1"]["task"] )
+		s["n3"] = GafferDispatchTest.LoggingTaskNode( log = log )
+		s["n3"]["preTasks"][0].setInput( s["n2"]["task"] )
+
+		self.assertTrue( s["n1"]["task"].hashCoversInputs() )
+		self.assertFalse( s["n2"]["task"].hashCoversInputs() )
+
+		dispatcher = GafferDispatch.Dispatcher.create( "testDispatcher" )
+		dispatcher["skipUnchangedTasks"].setValue( True )
+
+		dispatcher.dispatch( [ s["n3"] ] )
+		self.assertEqual( [ l.node for l in log ], [ s["n1"], s["n2"], s["n3"] ] )
+
+		# `n2` must always be executed, and so must `n3`
+		# because it depends on the results of `n2`.
+
+		del log[:]
+		dispatcher.dispatch( [ s["n3"] ] )
+		self.assertEqual( [ l.node for l in log ], [ s["n2"], s["n3"] ] )
+
 	def testTaskListWaitForSequence( self ) :
 
 		s = Gaffer.ScriptNode()
@@ -40,6 +40,7 @@ import subprocess32 as subprocess
 import unittest
 import glob
 import inspect
+import json
 import imath
 
 import IECore
@@ -331,5 +332,39 @@ class ExecuteApplicationTest( GafferTest.TestCase ) :
 			"0.0 1.0 2.0"
 		)
 
+	def testReport( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["t"] = GafferDispatchTest.TextWriter()
+		s["t"]["fileName"].setValue( self.temporaryDirectory() + "/test.####.txt" )
+
+		# Use an expression so that there are computes
+		# for the PerformanceMonitor to record.
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent["t"]["text"] = "test"' )
+
+		s["fileName"].setValue( self.__scriptFileName )
+		s.save()
+
+		reportFileName = self.temporaryDirectory() + "/report.json"
+		subprocess.check_call( [ "gaffer", "execute", self.__scriptFileName, "-frames", "1-3", "-report", reportFileName ] )
+
+		with open( reportFileName ) as f :
+			report = json.load( f )
+
+		self.assertEqual( report["frames"], [ 1, 2, 3 ] )
+		self.assertEqual( report["result"], 0 )
+		for key in [ "wallTime", "userTime", "systemTime", "maxRSS", "blocksIn", "blocksOut", "cacheMemoryUsage", "cacheMemoryLimit" ] :
+			self.assertGreaterEqual( report[key], 0 )
+		self.assertNotIn( "performance", report )
+
+		subprocess.check_call( [ "gaffer", "execute", self.__scriptFileName, "-frames", "1-3", "-report", reportFileName, "-performanceMonitor" ] )
+
+		with open( reportFileName ) as f :
+			report = json.load( f )
+
+		self.assertIn( "performance", report )
+		self.assertGreater( report["performance"]["hashCount"], 0 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -41,6 +41,8 @@ import unittest
 import time
 import inspect
 import functools
+import threading
+import json
 
 import imath
 
@@ -796,6 +798,231 @@ class LocalDispatcherTest( GafferTest.TestCase ) :
 
 		d.jobPool().waitForAll()
 
+	def testMaxConcurrentTasks( self ) :
+
+		# Each command waits for the other to start, so they
+		# can only succeed if they are executed concurrently.
+
+		s = Gaffer.ScriptNode()
+		s["l"] = GafferDispatch.TaskList()
+
+		for name, otherName in ( ( "a", "b" ), ( "b", "a" ) ) :
+
+			c = GafferDispatch.PythonCommand()
+			c["command"].setValue( inspect.cleandoc(
+				"""
+				import os
+				import time
+				open( "{directory}/{name}", "w" ).close()
+				startTime = time.time()
+				while not os.path.exists( "{directory}/{otherName}" ) and time.time() - startTime < 10 :
+					time.sleep( 0.01 )
+				assert( os.path.exists( "{directory}/{otherName}" ) )
+				""".format( directory = self.temporaryDirectory(), name = name, otherName = otherName )
+			) )
+			s[name] = c
+			s["l"]["preTasks"][len( s["l"]["preTasks"] ) - 1].setInput( c["task"] )
+
+		d = GafferDispatch.Dispatcher.create( "LocalTest" )
+		d["executeInBackground"].setValue( True )
+		d["maxConcurrentTasks"].setValue( 2 )
+		d.dispatch( [ s["l"] ] )
+		job = d.jobPool().jobs()[0]
+		d.jobPool().waitForAll()
+
+		self.assertFalse( job.failed() )
+
+		# Foreground dispatches only execute the tasks concurrently
+		# when explicitly requested, in which case they use separate
+		# threads.
+
+		for name in ( "a", "b" ) :
+			os.remove( os.path.join( self.temporaryDirectory(), name ) )
+
+		d["executeInBackground"].setValue( False )
+		d["concurrentForegroundTasks"].setValue( True )
+		d.dispatch( [ s["l"] ] )
+		self.assertEqual( len( d.jobPool().jobs() ), 0 )
+
+	def testMaxConcurrentTasksForegroundFailure( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["c"] = GafferDispatch.PythonCommand()
+		s["c"]["command"].setValue( "raise Exception( \"Oops\" )" )
+
+		d = GafferDispatch.Dispatcher.create( "LocalTest" )
+		d["maxConcurrentTasks"].setValue( 4 )
+		d["concurrentForegroundTasks"].setValue( True )
+
+		self.assertRaisesRegexp( Exception, "Oops", d.dispatch, [ s["c"] ] )
+		self.assertEqual( len( d.jobPool().jobs() ), 0 )
+
+	def testForegroundTasksAreSequentialByDefault( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["c"] = GafferDispatch.PythonCommand()
+		s["c"]["command"].setValue( inspect.cleandoc(
+			"""
+			import threading
+			with open( "{fileName}", "w" ) as f :
+				f.write( threading.current_thread().name )
+			""".format( fileName = os.path.join( self.temporaryDirectory(), "thread" ) )
+		) )
+
+		# Executing tasks on other threads is only safe if they
+		# are thread-safe, so it must never happen implicitly.
+
+		d = GafferDispatch.Dispatcher.create( "LocalTest" )
+		d["maxConcurrentTasks"].setValue( 4 )
+		d.dispatch( [ s["c"] ] )
+
+		with open( os.path.join( self.temporaryDirectory(), "thread" ) ) as f :
+			self.assertEqual( f.read(), threading.current_thread().name )
+
+	def testUseWorkers( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["c"] = GafferDispatch.PythonCommand()
+		s["c"]["command"].setValue( inspect.cleandoc(
+			"""
+			import os
+			with open( "{directory}/%d" % context.getFrame(), "w" ) as f :
+				f.write( str( os.getpid() ) )
+			""".format( directory = self.temporaryDirectory() )
+		) )
+
+		d = GafferDispatch.Dispatcher.create( "LocalTest" )
+		d["executeInBackground"].setValue( True )
+		d["useWorkers"].setValue( True )
+		d["framesMode"].setValue( d.FramesMode.CustomRange )
+		d["frameRange"].setValue( "1-5" )
+		d.dispatch( [ s["c"] ] )
+		job = d.jobPool().jobs()[0]
+		d.jobPool().waitForAll()
+
+		self.assertFalse( job.failed() )
+
+		# All batches should have been executed by the same worker.
+		pids = set()
+		for frame in range( 1, 6 ) :
+			with open( os.path.join( self.temporaryDirectory(), str( frame ) ) ) as f :
+				pids.add( f.read() )
+
+		self.assertEqual( len( pids ), 1 )
+
+	def testRecordTelemetry( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["c"] = GafferDispatch.PythonCommand()
+		s["c"]["command"].setValue( "pass" )
+
+		d = GafferDispatch.Dispatcher.create( "LocalTest" )
+		d["framesMode"].setValue( d.FramesMode.CustomRange )
+		d["frameRange"].setValue( "1-3" )
+		d["recordTelemetry"].setValue( True )
+
+		# Foreground execution records the timing of each batch.
+
+		d.dispatch( [ s["c"] ] )
+
+		with open( os.path.join( d.jobDirectory(), "timeline.json" ) ) as f :
+			timeline = json.load( f )
+
+		self.assertEqual( [ b["frames"] for b in timeline["batches"] ], [ [ 1 ], [ 2 ], [ 3 ] ] )
+		for b in timeline["batches"] :
+			self.assertEqual( b["node"], "c" )
+			self.assertEqual( b["status"], "Complete" )
+			self.assertLessEqual( b["startTime"], b["endTime"] )
+			self.assertNotIn( "report", b )
+
+		# Background execution also includes the reports
+		# from `gaffer execute`.
+
+		for useWorkers in ( False, True ) :
+
+			d["executeInBackground"].setValue( True )
+			d["useWorkers"].setValue( useWorkers )
+			d.dispatch( [ s["c"] ] )
+			job = d.jobPool().jobs()[0]
+			d.jobPool().waitForAll()
+			self.assertFalse( job.failed() )
+
+			with open( os.path.join( d.jobDirectory(), "timeline.json" ) ) as f :
+				timeline = json.load( f )
+
+			self.assertEqual( timeline["batches"], job.timeline() )
+			self.assertEqual( sorted( b["frames"] for b in timeline["batches"] ), [ [ 1 ], [ 2 ], [ 3 ] ] )
+			for b in timeline["batches"] :
+				self.assertEqual( b["status"], "Complete" )
+				self.assertEqual( b["report"]["frames"], b["frames"] )
+				self.assertEqual( b["report"]["result"], 0 )
+				self.assertGreater( b["report"]["maxRSS"], 0 )
+
+	def testWorkerFailure( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["c"] = GafferDispatch.PythonCommand()
+		s["c"]["command"].setValue( "raise Exception( \"Oops\" )" )
+
+		d = GafferDispatch.Dispatcher.create( "LocalTest" )
+		d["executeInBackground"].setValue( True )
+		d["useWorkers"].setValue( True )
+		d.dispatch( [ s["c"] ] )
+		job = d.jobPool().jobs()[0]
+		d.jobPool().waitForAll()
+
+		self.assertTrue( job.failed() )
+
+	def testResourceRequirements( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["l"] = GafferDispatch.TaskList()
+
+		for name in ( "a", "b" ) :
+
+			c = GafferDispatch.PythonCommand()
+			c["command"].setValue( inspect.cleandoc(
+				"""
+				import time
+				with open( "{directory}/{name}", "w" ) as f :
+					f.write( "%f " % time.time() )
+					time.sleep( 0.5 )
+					f.write( "%f" % time.time() )
+				""".format( directory = self.temporaryDirectory(), name = name )
+			) )
+			c["dispatcher"]["local"]["threads"].setValue( 3 )
+			c["dispatcher"]["local"]["memory"].setValue( 3 )
+			s[name] = c
+			s["l"]["preTasks"][len( s["l"]["preTasks"] ) - 1].setInput( c["task"] )
+
+		d = GafferDispatch.Dispatcher.create( "LocalTest" )
+		d["executeInBackground"].setValue( True )
+		d["maxConcurrentTasks"].setValue( 2 )
+		d["maxMemory"].setValue( 4 )
+		d.dispatch( [ s["l"] ] )
+		job = d.jobPool().jobs()[0]
+		d.jobPool().waitForAll()
+
+		self.assertFalse( job.failed() )
+
+		# The tasks don't fit in memory together, so must
+		# not have been executed concurrently.
+
+		intervals = []
+		for name in ( "a", "b" ) :
+			with open( os.path.join( self.temporaryDirectory(), name ) ) as f :
+				intervals.append( [ float( t ) for t in f.read().split() ] )
+
+		intervals.sort()
+		self.assertLessEqual( intervals[0][1], intervals[1][0] )
+
+		# And the thread count should have been passed
+		# to the processes.
+
+		self.assertTrue(
+			any( "-threads 3" in m.message for m in job.messageHandler().messages )
+		)
+
 	def testImathContextVariable( self ) :
 
 		s = Gaffer.ScriptNode()
@@ -99,4 +99,8 @@ class LoggingTaskNode( GafferDispatch.TaskNode ) :
 
 		return self["requiresSequenceExecution"].getValue()
 
+	def hashCoversInputs( self ) :
+
+		return True
+
 IECore.registerRunTimeTyped( LoggingTaskNode, typeName = "GafferDispatchTest::LoggingTaskNode" )
@@ -118,6 +118,36 @@ Gaffer.Metadata.registerNode(
 
 		),
 
+		"skipUnchangedTasks" : (
+
+			"description",
+			"""
+			Skips tasks which were executed successfully by a previous
+			dispatch with the same job name, provided that neither they
+			nor any of their upstream tasks have changed since. Only
+			tasks which can reliably detect changes to all their inputs
+			are skipped, such as the SystemCommand. Writers such as the
+			ImageWriter and SceneWriter are always executed, as are all
+			tasks downstream of them. Note that tasks are not re-executed
+			if their outputs have been deleted or modified externally.
+			""",
+
+		),
+
+		"targetBatchDuration" : (
+
+			"description",
+			"""
+			When greater than zero, chooses the batch size for each
+			task automatically, so that each batch takes approximately
+			this many seconds to execute. Execution times are recorded
+			by each dispatch with the same job name and used by the
+			next, so tasks which haven't been dispatched before use their
+			own batch size.
+			""",
+
+		),
+
 	}
 
 )
@@ -97,6 +97,135 @@ Gaffer.Metadata.registerNode(
 
 		),
 
+		"maxConcurrentTasks" : (
+
+			"description",
+			"""
+			The maximum number of tasks to execute at the same time
+			when executing in the background, or in the foreground
+			with `concurrentForegroundTasks` turned on. Tasks are
+			launched as soon as all the tasks they depend on have
+			completed, so independent branches of the task graph
+			may run concurrently.
+			""",
+
+		),
+
+		"concurrentForegroundTasks" : (
+
+			"description",
+			"""
+			Allows foreground dispatches to execute up to `maxConcurrentTasks`
+			tasks at the same time. Rather than running in separate processes
+			as background tasks do, these tasks run on separate threads within
+			the current process, sharing its cache.
+
+			> Caution : This is only safe if the `execute()` methods of all
+			> the dispatched tasks are thread-safe. Tasks which modify the
+			> script or rely on global state must not be executed this way.
+			""",
+
+		),
+
+		"useWorkers" : (
+
+			"description",
+			"""
+			Executes background tasks using a pool of persistent
+			`gaffer execute -worker` processes, rather than launching
+			a new process for each task. Each worker loads the script
+			only once, and keeps its cache between tasks, which can
+			greatly reduce the overhead for jobs with many small tasks.
+			""",
+
+		),
+
+		"maxThreads" : (
+
+			"description",
+			"""
+			The number of threads available for executing tasks
+			concurrently. Tasks are only launched together if the
+			sum of the threads they declare via their
+			`dispatcher.local.threads` plugs fits within this limit.
+			A value of 0 uses the number of cores on the machine.
+			""",
+
+		),
+
+		"maxMemory" : (
+
+			"description",
+			"""
+			The memory (in GB) available for executing tasks
+			concurrently. Tasks are only launched together if the
+			sum of the memory they declare via their
+			`dispatcher.local.memory` plugs fits within this limit.
+			A value of 0 places no limit on memory.
+			""",
+
+		),
+
+		"recordTelemetry" : (
+
+			"description",
+			"""
+			Writes a "timeline.json" file to the job directory,
+			recording the start and end time of each task. Tasks
+			executed in the background also record the CPU time,
+			peak memory usage, I/O volume and cache usage reported
+			by `gaffer execute -report`.
+			""",
+
+		),
+
+	}
+
+)
+
+Gaffer.Metadata.registerNode(
+
+	GafferDispatch.TaskNode,
+
+	plugs = {
+
+		"dispatcher.local" : (
+
+			"description",
+			"""
+			Settings that control how tasks are
+			executed by the LocalDispatcher.
+			""",
+
+			"layout:section", "Local",
+			"plugValueWidget:type", "GafferUI.LayoutPlugValueWidget",
+
+		),
+
+		"dispatcher.local.threads" : (
+
+			"description",
+			"""
+			The number of threads the task requires. This is used
+			to avoid oversubscribing the machine when executing tasks
+			concurrently, and limits the threads used by the process
+			executing the task. A value of 0 leaves the thread count
+			unconstrained.
+			""",
+
+		),
+
+		"dispatcher.local.memory" : (
+
+			"description",
+			"""
+			The memory (in GB) the task requires. This is used to
+			avoid running out of memory when executing tasks
+			concurrently.
+			""",
+
+		),
+
 	}
 
 )
@@ -49,4 +49,8 @@ __setupEnvironment()
 from _GafferImage import *
 from CatalogueSelect import CatalogueSelect
 
+# Make sure that images received by Catalogues are not
+# lost when the application exits before saving them.
+__import__( "atexit" ).register( Catalogue.waitForSaves )
+
 __import__( "IECore" ).loadConfig( "GAFFER_STARTUP_PATHS", subdirectory = "GafferImage" )
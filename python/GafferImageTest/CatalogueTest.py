@@ -35,11 +35,14 @@
 ##########################################################################
 
 import os
+import thread
 import threading
+import time
 import stat
 import imath
 
 import IECore
+import IECoreImage
 
 import Gaffer
 import GafferTest
@@ -63,6 +66,85 @@ class CatalogueTest( GafferImageTest.ImageTestCase ) :
 
 			return GafferImageTest.DisplayTest.Driver.sendImage( image, GafferImage.Catalogue.displayDriverServer().portNumber(), extraParameters, close = close )
 
+	# Services `ParallelAlgo::callOnUIThread()` by queuing the calls
+	# to be run explicitly by the test. While `hold()` is in effect,
+	# calls from background threads are also blocked until `release()`,
+	# allowing a test to keep the background save thread busy while
+	# it arranges the save queue.
+	class UIThreadCalls( object ) :
+
+		def __init__( self, test ) :
+
+			self.__test = test
+			self.__calls = []
+			self.__numBlocked = 0
+			self.__released = threading.Event()
+			self.__released.set()
+			self.__mainThread = thread.get_ident()
+
+			Gaffer.ParallelAlgo.registerUIThreadCallHandler( self.__callOnUIThread )
+			test.addCleanup( self.__cleanup )
+
+		def hold( self ) :
+
+			self.__released.clear()
+
+		def release( self ) :
+
+			self.__released.set()
+
+		def waitForBlocked( self, n ) :
+
+			self.__waitFor( lambda : self.__numBlocked >= n )
+
+		def run( self, n ) :
+
+			for i in range( 0, n ) :
+				self.__waitFor( lambda : len( self.__calls ) )
+				self.__calls.pop( 0 )()
+
+		def __callOnUIThread( self, f ) :
+
+			self.__calls.append( f )
+			if thread.get_ident() != self.__mainThread and not self.__released.is_set() :
+				self.__numBlocked += 1
+				self.__released.wait()
+
+		def __waitFor( self, condition ) :
+
+			t = time.time()
+			while not condition() and time.time() - t < 10 :
+				time.sleep( 0.01 )
+
+			self.__test.assertTrue( condition() )
+
+		def __cleanup( self ) :
+
+			self.release()
+			GafferImage.Catalogue.waitForSaves()
+			Gaffer.ParallelAlgo.registerUIThreadCallHandler( None )
+
+	# Sends an empty image to the catalogue without closing it, running the
+	# UI thread call that inserts it. The image width is used to make each
+	# image unique.
+	@staticmethod
+	def createDriver( width, uiThreadCalls ) :
+
+		format = GafferImage.Format( width, 64 )
+		driver = IECoreImage.ClientDisplayDriver(
+			format.toEXRSpace( format.getDisplayWindow() ),
+			format.toEXRSpace( format.getDisplayWindow() ),
+			[ "R", "G", "B", "A" ],
+			{
+				"displayHost" : "localHost",
+				"displayPort" : str( GafferImage.Catalogue.displayDriverServer().portNumber() ),
+				"remoteDisplayType" : "GafferImage::GafferDisplayDriver",
+			}
+		)
+		uiThreadCalls.run( 1 )
+
+		return driver
+
 	def testImages( self ) :
 
 		images = []
@@ -190,13 +272,125 @@ class CatalogueTest( GafferImageTest.ImageTestCase ) :
 		self.assertImagesEqual( r["out"], c["out"], ignoreMetadata = True )
 
 		r["fileName"].setValue( "${GAFFER_ROOT}/python/GafferImageTest/images/blurRange.exr" )
-		self.sendImage( r["out"], c )
+		with GafferTest.ParallelAlgoTest.ExpectedUIThreadCall() :
+			# Wait for the first image to be compressed in the background.
+			self.sendImage( r["out"], c )
 
 		self.assertEqual( len( c["images"] ), 2 )
 		self.assertEqual( c["images"][1]["fileName"].getValue(), "" )
 		self.assertEqual( c["imageIndex"].getValue(), 1 )
 		self.assertImagesEqual( r["out"], c["out"], ignoreMetadata = True )
 
+	def testInactiveImagesAreCompressed( self ) :
+
+		c = GafferImage.Catalogue()
+
+		r1 = GafferImage.ImageReader()
+		r1["fileName"].setValue( "${GAFFER_ROOT}/python/GafferImageTest/images/checker.exr" )
+		self.sendImage( r1["out"], c )
+		uncompressedUsage = c["images"][0].memoryUsage()
+		self.assertGreater( uncompressedUsage, 0 )
+
+		r2 = GafferImage.ImageReader()
+		r2["fileName"].setValue( "${GAFFER_ROOT}/python/GafferImageTest/images/blurRange.exr" )
+		with GafferTest.ParallelAlgoTest.ExpectedUIThreadCall() :
+			self.sendImage( r2["out"], c )
+
+		# Receiving the second image makes the first one inactive,
+		# so it should have been compressed in the background.
+
+		self.assertEqual( c["imageIndex"].getValue(), 1 )
+		self.assertLess( c["images"][0].memoryUsage(), uncompressedUsage )
+		self.assertImagesEqual( c["out"], r2["out"], ignoreMetadata = True )
+
+		uncompressedUsage = c["images"][1].memoryUsage()
+		with GafferTest.ParallelAlgoTest.ExpectedUIThreadCall() :
+			c["imageIndex"].setValue( 0 )
+		self.assertLess( c["images"][1].memoryUsage(), uncompressedUsage )
+
+		# Compression must be lossless.
+
+		self.assertImagesEqual( c["out"], r1["out"], ignoreMetadata = True )
+		c["imageIndex"].setValue( 1 )
+		self.assertImagesEqual( c["out"], r2["out"], ignoreMetadata = True )
+
+		# And compressed images can still be copied.
+
+		c["images"].addChild( c.Image( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic ) )
+		c["images"][2].copyFrom( c["images"][0] )
+		c["imageIndex"].setValue( 2 )
+		self.assertImagesEqual( c["out"], r1["out"], ignoreMetadata = True )
+
+	def testCompressionIsNotUndoable( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["c"] = GafferImage.Catalogue()
+
+		r1 = GafferImage.ImageReader()
+		r1["fileName"].setValue( "${GAFFER_ROOT}/python/GafferImageTest/images/checker.exr" )
+		self.sendImage( r1["out"], s["c"] )
+
+		r2 = GafferImage.ImageReader()
+		r2["fileName"].setValue( "${GAFFER_ROOT}/python/GafferImageTest/images/blurRange.exr" )
+		with GafferTest.ParallelAlgoTest.ExpectedUIThreadCall() :
+			self.sendImage( r2["out"], s["c"] )
+
+		# Changing the image index compresses the previously active image
+		# in the background. This must not interfere with undo.
+
+		uncompressedUsage = s["c"]["images"][1].memoryUsage()
+		with GafferTest.ParallelAlgoTest.ExpectedUIThreadCall() :
+			with Gaffer.UndoScope( s ) :
+				s["c"]["imageIndex"].setValue( 0 )
+
+		self.assertLess( s["c"]["images"][1].memoryUsage(), uncompressedUsage )
+		self.assertImagesEqual( s["c"]["out"], r1["out"], ignoreMetadata = True )
+
+		s.undo()
+		self.assertFalse( s.undoAvailable() )
+		self.assertEqual( s["c"]["imageIndex"].getValue(), 1 )
+		self.assertLess( s["c"]["images"][1].memoryUsage(), uncompressedUsage )
+		self.assertImagesEqual( s["c"]["out"], r2["out"], ignoreMetadata = True )
+
+		s.redo()
+		self.assertEqual( s["c"]["imageIndex"].getValue(), 0 )
+		self.assertImagesEqual( s["c"]["out"], r1["out"], ignoreMetadata = True )
+
+	def testUndoCopyAfterSwitchingImage( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["c"] = GafferImage.Catalogue()
+
+		r1 = GafferImage.ImageReader()
+		r1["fileName"].setValue( "${GAFFER_ROOT}/python/GafferImageTest/images/checker.exr" )
+		self.sendImage( r1["out"], s["c"] )
+
+		# Duplicate the image, as the CatalogueUI does. Switching to
+		# the copy compresses the original.
+
+		with GafferTest.ParallelAlgoTest.ExpectedUIThreadCall() :
+			with Gaffer.UndoScope( s ) :
+				imageCopy = s["c"].Image( "imageCopy", flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+				s["c"]["images"].addChild( imageCopy )
+				imageCopy.copyFrom( s["c"]["images"][0] )
+				s["c"]["imageIndex"].setValue( 1 )
+
+		# But switching away from the copy must not compress it, because
+		# undo needs to remove the Display nodes that were copied.
+
+		uncompressedUsage = imageCopy.memoryUsage()
+		s["c"]["imageIndex"].setValue( 0 )
+		self.assertEqual( imageCopy.memoryUsage(), uncompressedUsage )
+
+		s.undo()
+		self.assertEqual( len( s["c"]["images"] ), 1 )
+		self.assertImagesEqual( s["c"]["out"], r1["out"], ignoreMetadata = True )
+
+		s.redo()
+		self.assertEqual( len( s["c"]["images"] ), 2 )
+		s["c"]["imageIndex"].setValue( 1 )
+		self.assertImagesEqual( s["c"]["out"], r1["out"], ignoreMetadata = True )
+
 	def testDisplayDriverAOVGrouping( self ) :
 
 		c = GafferImage.Catalogue()
@@ -546,6 +740,70 @@ class CatalogueTest( GafferImageTest.ImageTestCase ) :
 			self.sendImage( r["out"], c, waitForSave = False )
 			del c
 
+	def testSaveOrder( self ) :
+
+		c = GafferImage.Catalogue()
+		c["directory"].setValue( os.path.join( self.temporaryDirectory(), "catalogue" ) )
+
+		uiThreadCalls = self.UIThreadCalls( self )
+		drivers = [ self.createDriver( 64 + i, uiThreadCalls ) for i in range( 0, 4 ) ]
+		self.assertEqual( len( c["images"] ), 4 )
+		self.assertEqual( c["imageIndex"].getValue(), 3 )
+
+		for driver in drivers :
+			driver.imageClose()
+
+		# Complete the first render, which starts saving immediately. Then
+		# hold the background thread when it tries to wrap up, so that the
+		# remaining saves stay in the queue.
+
+		uiThreadCalls.hold()
+		uiThreadCalls.run( 1 )
+		uiThreadCalls.waitForBlocked( 1 )
+
+		# Complete the remaining renders. Each completion moves the save for
+		# the active image to the front of the queue, and so does changing
+		# the active image.
+
+		uiThreadCalls.run( 3 )
+		c["imageIndex"].setValue( 2 )
+
+		# Run the wrap ups, and check the images were saved in priority order.
+
+		uiThreadCalls.release()
+
+		saved = []
+		for i in range( 0, 4 ) :
+			uiThreadCalls.run( 1 )
+			saved.extend( [ j for j in range( 0, 4 ) if c["images"][j]["fileName"].getValue() and j not in saved ] )
+
+		self.assertEqual( saved, [ 0, 2, 3, 1 ] )
+
+	def testDeleteBeforeSaveStarts( self ) :
+
+		c = GafferImage.Catalogue()
+		directory = os.path.join( self.temporaryDirectory(), "catalogue" )
+		c["directory"].setValue( directory )
+
+		uiThreadCalls = self.UIThreadCalls( self )
+		drivers = [ self.createDriver( 64 + i, uiThreadCalls ) for i in range( 0, 2 ) ]
+		for driver in drivers :
+			driver.imageClose()
+
+		# Hold the background thread once it has saved the first image,
+		# so that the save for the second is still queued.
+
+		uiThreadCalls.hold()
+		uiThreadCalls.run( 2 )
+		uiThreadCalls.waitForBlocked( 1 )
+		self.assertEqual( len( os.listdir( directory ) ), 1 )
+
+		# Deleting the second image must remove it from the queue,
+		# but the image must still be saved rather than lost.
+
+		del c["images"][1]
+		self.assertEqual( len( os.listdir( directory ) ), 2 )
+
 	def testDeleteBeforeSaveCompletesWithScriptVariables( self ) :
 
 		s = Gaffer.ScriptNode()
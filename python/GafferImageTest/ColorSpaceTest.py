@@ -254,5 +254,28 @@ class ColorSpaceTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertEqual( c2["out"].channelData( "R", imath.V2i( 0 ) ), c1["out"].channelData( "R", imath.V2i( 0 ) ) )
 
+	def testChangingSpaces( self ) :
+
+		n = GafferImage.ImageReader()
+		n["fileName"].setValue( self.fileName )
+
+		o = GafferImage.ColorSpace()
+		o["in"].setInput( n["out"] )
+		o["inputSpace"].setValue( "linear" )
+
+		# Processors are cached between computes, so make sure that
+		# we always get the one matching the current spaces.
+
+		images = {}
+		for outputSpace in [ "sRGB", "rec709", "sRGB" ] :
+			o["outputSpace"].setValue( outputSpace )
+			image = o["out"].image()
+			if outputSpace in images :
+				self.assertEqual( image, images[outputSpace] )
+			else :
+				images[outputSpace] = image
+
+		self.assertNotEqual( images["sRGB"], images["rec709"] )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -129,6 +129,40 @@ class CopyChannelsTest( GafferImageTest.ImageTestCase ) :
 					else :
 						self.assertEqual( sampler.sample( x, y ), 0 )
 
+	def testTilesOutsideDataWindowAreShared( self ) :
+
+		main = self.__constantLayer( "", imath.Color4f( 1 ), size = imath.V2i( 512 ) )
+		diffuse = self.__constantLayer( "diffuse", imath.Color4f( 0.5 ), size = imath.V2i( 60 ) )
+
+		copy = GafferImage.CopyChannels()
+		copy["in"][0].setInput( main["out"] )
+		copy["in"][1].setInput( diffuse["out"] )
+		copy["channels"].setValue( "*" )
+
+		# Tiles which don't overlap the data window of the input
+		# they are copied from should all share a single black tile,
+		# rather than each allocating their own.
+
+		tileSize = GafferImage.ImagePlug.tileSize()
+		tile1 = imath.V2i( tileSize )
+		tile2 = imath.V2i( tileSize * 2, tileSize )
+
+		self.assertEqual(
+			copy["out"].channelDataHash( "diffuse.R", tile1 ),
+			copy["out"].channelDataHash( "diffuse.G", tile2 ),
+		)
+
+		self.assertTrue(
+			copy["out"].channelData( "diffuse.R", tile1, _copy = False ).isSame(
+				copy["out"].channelData( "diffuse.G", tile2, _copy = False )
+			)
+		)
+
+		self.assertEqual(
+			copy["out"].channelData( "diffuse.R", tile1 ),
+			IECore.FloatVectorData( [ 0 ] * tileSize * tileSize )
+		)
+
 	def testChannelsPlug( self ) :
 
 		main = self.__constantLayer( "", imath.Color4f( 1, 0.5, 0.25, 1 ) )
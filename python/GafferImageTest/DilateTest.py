@@ -138,5 +138,35 @@ class DilateTest( GafferImageTest.ImageTestCase ) :
 			# a master
 			self.assertImagesEqual( masterDilateSingleChannel["out"], defaultDilateSingleChannel["out"] )
 
+	def testMatchesDriverChannel( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( os.path.dirname( __file__ ) + "/images/circles.exr" )
+
+		# When the master channel is the only channel, the result must be
+		# the same as that computed by the faster default code path.
+
+		singleChannel = GafferImage.DeleteChannels()
+		singleChannel["in"].setInput( r["out"] )
+		singleChannel["mode"].setValue( GafferImage.DeleteChannels.Mode.Keep )
+		singleChannel["channels"].setValue( "G" )
+
+		masterDilate = GafferImage.Dilate()
+		masterDilate["in"].setInput( singleChannel["out"] )
+		masterDilate["masterChannel"].setValue( "G" )
+
+		defaultDilate = GafferImage.Dilate()
+		defaultDilate["in"].setInput( singleChannel["out"] )
+
+		for radius in [ imath.V2i( 1 ), imath.V2i( 3, 0 ), imath.V2i( 0, 2 ), imath.V2i( 5, 2 ) ] :
+			for boundingMode in [ GafferImage.Sampler.BoundingMode.Black, GafferImage.Sampler.BoundingMode.Clamp ] :
+				for expandDataWindow in [ False, True ] :
+					for n in [ masterDilate, defaultDilate ] :
+						n["radius"].setValue( radius )
+						n["boundingMode"].setValue( boundingMode )
+						n["expandDataWindow"].setValue( expandDataWindow )
+
+					self.assertImagesEqual( defaultDilate["out"], masterDilate["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
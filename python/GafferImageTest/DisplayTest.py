@@ -37,6 +37,7 @@
 import os
 import unittest
 import random
+import time
 import threading
 import subprocess32 as subprocess
 import imath
@@ -274,6 +275,99 @@ class DisplayTest( GafferImageTest.ImageTestCase ) :
 
 		driver.close()
 
+	def testUpdateInterval( self ) :
+
+		previousInterval = GafferImage.Display.getUpdateInterval()
+		self.addCleanup( GafferImage.Display.setUpdateInterval, previousInterval )
+
+		GafferImage.Display.setUpdateInterval( 0.5 )
+		self.assertEqual( GafferImage.Display.getUpdateInterval(), 0.5 )
+
+		node = GafferImage.Display()
+		server = IECoreImage.DisplayDriverServer()
+		driverCreatedConnection = GafferImage.Display.driverCreatedSignal().connect( lambda driver, parameters : node.setDriver( driver ) )
+
+		dataWindow = imath.Box2i( imath.V2i( 0 ), imath.V2i( 100 ) )
+		driver = self.Driver(
+			GafferImage.Format( dataWindow ),
+			dataWindow,
+			[ "Y" ],
+			port = server.portNumber(),
+		)
+
+		# The second update is delayed until the interval has passed,
+		# but must still arrive.
+
+		for value in ( 0.5, 1 ) :
+			driver.sendBucket( dataWindow, [ IECore.FloatVectorData( [ value ] * dataWindow.size().x * dataWindow.size().y ) ] )
+			self.assertEqual(
+				node["out"].channelData( "Y", imath.V2i( 0 ) ),
+				IECore.FloatVectorData( [ value ] * GafferImage.ImagePlug.tileSize() * GafferImage.ImagePlug.tileSize() )
+			)
+
+		driver.close()
+
+	def testDataVisibleWithoutEventLoop( self ) :
+
+		# Emulate a process where UI thread calls are accepted but never
+		# run, as is the case when there is no event loop. Data must still
+		# be visible as soon as it has been received.
+
+		previousInterval = GafferImage.Display.getUpdateInterval()
+		self.addCleanup( GafferImage.Display.setUpdateInterval, previousInterval )
+		GafferImage.Display.setUpdateInterval( 0 )
+
+		uiThreadCalls = []
+		Gaffer.ParallelAlgo.registerUIThreadCallHandler( uiThreadCalls.append )
+		self.addCleanup( Gaffer.ParallelAlgo.registerUIThreadCallHandler, None )
+
+		def waitForUIThreadCalls( n ) :
+			t = time.time()
+			while len( uiThreadCalls ) < n and time.time() - t < 10 :
+				time.sleep( 0.01 )
+			self.assertEqual( len( uiThreadCalls ), n )
+
+		driversCreated = GafferTest.CapturingSlot( GafferImage.Display.driverCreatedSignal() )
+		server = IECoreImage.DisplayDriverServer()
+		dataWindow = imath.Box2i( imath.V2i( 0 ), imath.V2i( 100 ) )
+		format = GafferImage.Format( dataWindow )
+
+		driver = IECoreImage.ClientDisplayDriver(
+			format.toEXRSpace( format.getDisplayWindow() ),
+			format.toEXRSpace( dataWindow ),
+			[ "Y" ],
+			{
+				"displayHost" : "localHost",
+				"displayPort" : str( server.portNumber() ),
+				"remoteDisplayType" : "GafferImage::GafferDisplayDriver",
+			}
+		)
+
+		# Emit `driverCreatedSignal()` ourselves.
+		waitForUIThreadCalls( 1 )
+		uiThreadCalls.pop()()
+		self.assertEqual( len( driversCreated ), 1 )
+
+		display = GafferImage.Display()
+		display.setDriver( driversCreated[0][0] )
+
+		# The bucket has been received once the Display node has
+		# asked for an update, but we don't run the update.
+		driver.imageData( format.toEXRSpace( dataWindow ), IECore.FloatVectorData( [ 0.5 ] * dataWindow.size().x * dataWindow.size().y ) )
+		waitForUIThreadCalls( 1 )
+
+		self.assertEqual(
+			display["out"].channelData( "Y", imath.V2i( 0 ) ),
+			IECore.FloatVectorData( [ 0.5 ] * GafferImage.ImagePlug.tileSize() * GafferImage.ImagePlug.tileSize() )
+		)
+
+		# Run the outstanding calls, so as not to leave pending
+		# updates around for other tests.
+		driver.imageClose()
+		waitForUIThreadCalls( 2 )
+		for call in uiThreadCalls :
+			call()
+
 	def __testTransferImage( self, fileName ) :
 
 		imageReader = GafferImage.ImageReader()
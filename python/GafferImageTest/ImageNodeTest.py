@@ -106,6 +106,44 @@ class ImageNodeTest( GafferImageTest.ImageTestCase ) :
 		self.assertNodesConstructWithDefaultValues( GafferImage )
 		self.assertNodesConstructWithDefaultValues( GafferImageTest )
 
+	def testMipLevel( self ) :
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( imath.Box2i( imath.V2i( 0 ), imath.V2i( 200, 150 ) ), 1 ) )
+		c["color"].setValue( imath.Color4f( 0.25, 0.5, 0.75, 1 ) )
+
+		crop = GafferImage.Crop()
+		crop["in"].setInput( c["out"] )
+		crop["affectDisplayWindow"].setValue( False )
+		crop["area"].setValue( imath.Box2i( imath.V2i( 1 ), imath.V2i( 5 ) ) )
+
+		grade = GafferImage.Grade()
+		grade["in"].setInput( crop["out"] )
+		grade["multiply"].setValue( imath.Color3f( 2 ) )
+
+		fullResolutionHash = grade["out"].channelDataHash( "R", imath.V2i( 0 ) )
+
+		context = Gaffer.Context()
+		context["image:mipLevel"] = 1
+		with context :
+
+			self.assertEqual( c["out"]["format"].getValue().getDisplayWindow(), imath.Box2i( imath.V2i( 0 ), imath.V2i( 100, 75 ) ) )
+			self.assertEqual( c["out"]["dataWindow"].getValue(), imath.Box2i( imath.V2i( 0 ), imath.V2i( 100, 75 ) ) )
+			self.assertEqual( c["out"].channelData( "G", imath.V2i( 0 ) )[0], 0.5 )
+
+			# Each pixel is the average of a 2x2 block, with pixels outside
+			# the full resolution data window counting as black.
+			self.assertEqual( crop["out"]["dataWindow"].getValue(), imath.Box2i( imath.V2i( 0 ), imath.V2i( 3 ) ) )
+			channelData = crop["out"].channelData( "R", imath.V2i( 0 ) )
+			self.assertEqual( channelData[0], 0.25 * 0.25 )
+			self.assertEqual( channelData[1], 0.5 * 0.25 )
+			self.assertEqual( channelData[GafferImage.ImagePlug.tileSize() + 1], 0.25 )
+
+			# Grade computes directly at the reduced resolution.
+			self.assertEqual( grade["out"]["dataWindow"].getValue(), crop["out"]["dataWindow"].getValue() )
+			self.assertEqual( grade["out"].channelData( "R", imath.V2i( 0 ) )[0], 0.25 * 0.25 * 2 )
+			self.assertNotEqual( grade["out"].channelDataHash( "R", imath.V2i( 0 ) ), fullResolutionHash )
+
 	def setUp( self ) :
 
 		GafferTest.TestCase.setUp( self )
@@ -154,6 +154,39 @@ class ImagePlugTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertNotEqual( h, r['out'].imageHash() )
 
+	def testMultipleChannelAccessors( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( imath.Color4f( 0.25, 0.5, 0.75, 1 ) )
+		out = c["out"]
+
+		tileOrigin = imath.V2i( 0 )
+		blackTile = IECore.FloatVectorData( [ 0 ] * GafferImage.ImagePlug.tileSize() * GafferImage.ImagePlug.tileSize() )
+
+		# Missing channels are returned as black.
+
+		self.assertEqual(
+			out.channelData( [ "B", "R", "Z" ], tileOrigin ),
+			[ out.channelData( "B", tileOrigin ), out.channelData( "R", tileOrigin ), blackTile ]
+		)
+
+		h = IECore.MurmurHash()
+		h.append( out.channelDataHash( "B", tileOrigin ) )
+		h.append( out.channelDataHash( "R", tileOrigin ) )
+		h.append( blackTile.hash() )
+		self.assertEqual( out.channelDataHash( [ "B", "R", "Z" ], tileOrigin ), h )
+
+		# Unconnected inputs return the default value.
+
+		p = GafferImage.ImagePlug()
+		defaultValue = p["channelData"].defaultValue()
+		self.assertEqual( p.channelData( [ "R", "G" ], tileOrigin ), [ defaultValue, defaultValue ] )
+
+		h = IECore.MurmurHash()
+		h.append( defaultValue.hash() )
+		h.append( defaultValue.hash() )
+		self.assertEqual( p.channelDataHash( [ "R", "G" ], tileOrigin ), h )
+
 	def testDefaultFormatForImage( self ) :
 
 		constant = GafferImage.Constant()
@@ -459,5 +459,31 @@ class ImageReaderTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertImagesEqual( reader["out"], constant["out"] )
 
+	def testMipLevel( self ) :
+
+		# The colour space conversion isn't linear, so the reduced image
+		# must be filtered from the converted full resolution image,
+		# rather than being converted after filtering.
+
+		reader = GafferImage.ImageReader()
+		reader["fileName"].setValue( self.jpgFileName )
+
+		tileSize = GafferImage.ImagePlug.tileSize()
+		fullResolution = reader["out"].channelData( "R", imath.V2i( 0 ) )
+
+		context = Gaffer.Context()
+		context["image:mipLevel"] = 1
+		with context :
+			reduced = reader["out"].channelData( "R", imath.V2i( 0 ) )
+
+		for y in range( 0, tileSize / 2 ) :
+			for x in range( 0, tileSize / 2 ) :
+				i = y * 2 * tileSize + x * 2
+				self.assertAlmostEqual(
+					reduced[y*tileSize+x],
+					( fullResolution[i] + fullResolution[i+1] + fullResolution[i+tileSize] + fullResolution[i+tileSize+1] ) / 4.0,
+					places = 5
+				)
+
 if __name__ == "__main__":
 	unittest.main()
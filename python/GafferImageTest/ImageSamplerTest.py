@@ -93,5 +93,42 @@ class ImageSamplerTest( GafferImageTest.ImageTestCase ) :
 		sampler["channels"].setValue( IECore.StringVectorData( [ "diffuse.R", "diffuse.G", "diffuse.B", "diffuse.A" ] ) )
 		self.assertEqual( sampler["color"].getValue(), imath.Color4f( 1, 0.5, 0.25, 1 ) )
 
+	def testMipLevel( self ) :
+
+		# A horizontal ramp, where the red value is the x coordinate.
+
+		dataWindow = imath.Box2i( imath.V2i( 0 ), imath.V2i( 99, 9 ) )
+		image = IECoreImage.ImagePrimitive( dataWindow, dataWindow )
+		image["R"] = IECore.FloatVectorData( [ x for y in range( 0, 10 ) for x in range( 0, 100 ) ] )
+
+		ramp = GafferImage.ObjectToImage()
+		ramp["object"].setValue( image )
+
+		sampler = GafferImage.ImageSampler()
+		sampler["image"].setInput( ramp["out"] )
+		sampler["pixel"].setValue( imath.V2f( 60.5, 5.5 ) )
+
+		# Use the sample to drive a Grade, which computes
+		# its output directly at reduced resolutions.
+
+		constant = GafferImage.Constant()
+		constant["color"].setValue( imath.Color4f( 1 ) )
+
+		grade = GafferImage.Grade()
+		grade["in"].setInput( constant["out"] )
+		grade["multiply"]["r"].setInput( sampler["color"]["r"] )
+
+		self.assertEqual( grade["out"].channelData( "R", imath.V2i( 0 ) )[0], 60 )
+
+		# The sample must still be taken from the full resolution
+		# image when computing a reduced resolution version of
+		# the Grade's output.
+
+		context = Gaffer.Context()
+		context["image:mipLevel"] = 2
+		with context :
+			self.assertEqual( sampler["color"]["r"].getValue(), 60 )
+			self.assertEqual( grade["out"].channelData( "R", imath.V2i( 0 ) )[0], 60 )
+
 if __name__ == "__main__":
 	unittest.main()
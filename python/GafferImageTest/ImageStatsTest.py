@@ -40,6 +40,7 @@ import imath
 
 import IECore
 
+import Gaffer
 import GafferTest
 import GafferImage
 import GafferImageTest
@@ -160,6 +161,34 @@ class ImageStatsTest( GafferImageTest.ImageTestCase ) :
 		self.__assertColour( s["min"].getValue(), imath.Color4f( 0.25, 0, 0, 0.5 ) )
 		self.__assertColour( s["max"].getValue(), imath.Color4f( 0.5, 0.5, 0, 0.75 ) )
 
+	def testMipLevel( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( imath.Color4f( 0.25 ) )
+
+		crop = GafferImage.Crop()
+		crop["in"].setInput( c["out"] )
+		crop["affectDisplayWindow"].setValue( False )
+		crop["area"].setValue( imath.Box2i( imath.V2i( 1 ), imath.V2i( 5 ) ) )
+
+		s = GafferImage.ImageStats()
+		s["in"].setInput( crop["out"] )
+		s["area"].setValue( crop["area"].getValue() )
+
+		hash = s["min"].hash()
+		self.assertEqual( s["min"]["r"].getValue(), 0.25 )
+
+		# Statistics are always computed from the full resolution
+		# image, even when evaluated in a context requesting a
+		# reduced one.
+
+		context = Gaffer.Context()
+		context["image:mipLevel"] = 1
+		with context :
+			self.assertEqual( s["min"].hash(), hash )
+			self.assertEqual( s["min"]["r"].getValue(), 0.25 )
+			self.assertEqual( s["max"]["r"].getValue(), 0.25 )
+
 	def testMin( self ) :
 
 		c = GafferImage.Constant()
@@ -187,6 +216,51 @@ class ImageStatsTest( GafferImageTest.ImageTestCase ) :
 		self.assertEqual( s["min"].getValue(), imath.Color4f( 1 ) )
 		self.assertEqual( s["max"].getValue(), imath.Color4f( 1 ) )
 
+	def testNegativeValues( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( imath.Color4f( -1, -2, -3, -4 ) )
+
+		s = GafferImage.ImageStats()
+		s["in"].setInput( c["out"] )
+		s["area"].setValue( c["out"]["format"].getValue().getDisplayWindow() )
+
+		self.assertEqual( s["min"].getValue(), imath.Color4f( -1, -2, -3, -4 ) )
+		self.assertEqual( s["max"].getValue(), imath.Color4f( -1, -2, -3, -4 ) )
+		self.assertEqual( s["average"].getValue(), imath.Color4f( -1, -2, -3, -4 ) )
+
+	def testAreaSpanningTiles( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.__rgbFilePath )
+
+		s = GafferImage.ImageStats()
+		s["in"].setInput( r["out"] )
+		s["channels"].setValue( IECore.StringVectorData( [ "R", "G", "B", "A" ] ) )
+
+		# Areas straddling tile boundaries, and extending
+		# outside the data window, where pixels are black.
+		for area in [
+			imath.Box2i( imath.V2i( 10, 20 ), imath.V2i( 90, 80 ) ),
+			imath.Box2i( imath.V2i( 11, 20 ), imath.V2i( 90, 81 ) ),
+			imath.Box2i( imath.V2i( -30, -10 ), imath.V2i( 150, 70 ) ),
+		] :
+
+			s["area"].setValue( area )
+
+			for i, channelName in enumerate( "RGBA" ) :
+
+				sampler = GafferImage.Sampler( r["out"], channelName, area, GafferImage.Sampler.BoundingMode.Black )
+				values = [
+					sampler.sample( x, y )
+					for y in range( area.min().y, area.max().y )
+					for x in range( area.min().x, area.max().x )
+				]
+
+				self.assertAlmostEqual( s["min"][i].getValue(), min( values ), places = 5 )
+				self.assertAlmostEqual( s["max"][i].getValue(), max( values ), places = 5 )
+				self.assertAlmostEqual( s["average"][i].getValue(), sum( values ) / len( values ), places = 5 )
+
 	def __assertColour( self, colour1, colour2 ) :
 		for i in range( 0, 4 ):
 			self.assertEqual( "%.4f" % colour2[i], "%.4f" % colour1[i] )
@@ -39,6 +39,7 @@ import platform
 import unittest
 import shutil
 import functools
+import inspect
 import datetime
 import imath
 
@@ -993,6 +994,44 @@ class ImageWriterTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertTrue( os.path.isfile( s["w"]["fileName"].getValue() ) )
 
+	def testSkipUnchangedTasks( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["c"] = GafferImage.Constant()
+		s["c"]["color"].setValue( imath.Color4f( 1, 0, 0, 1 ) )
+
+		s["w"] = GafferImage.ImageWriter()
+		s["w"]["in"].setInput( s["c"]["out"] )
+		s["w"]["fileName"].setValue( self.temporaryDirectory() + "/test.exr" )
+
+		s["copy"] = GafferDispatch.SystemCommand()
+		s["copy"]["command"].setValue( "cp {0}/test.exr {0}/copy.exr".format( self.temporaryDirectory() ) )
+		s["copy"]["preTasks"][0].setInput( s["w"]["task"] )
+
+		d = GafferDispatch.LocalDispatcher()
+		d["jobsDirectory"].setValue( self.temporaryDirectory() + "/jobs" )
+		d["skipUnchangedTasks"].setValue( True )
+
+		with s.context() :
+			d.dispatch( [ s["copy"] ] )
+
+		s["r"] = GafferImage.ImageReader()
+		s["r"]["fileName"].setValue( self.temporaryDirectory() + "/copy.exr" )
+		self.assertImagesEqual( s["r"]["out"], s["c"]["out"], ignoreMetadata = True )
+
+		# The ImageWriter's hash doesn't account for its input image,
+		# so it must be executed even though the hash is unchanged.
+		# As must the downstream task, even though its own hash hasn't
+		# changed either.
+
+		s["c"]["color"].setValue( imath.Color4f( 0, 1, 0, 1 ) )
+		with s.context() :
+			d.dispatch( [ s["copy"] ] )
+
+		s["r"]["refreshCount"].setValue( s["r"]["refreshCount"].getValue() + 1 )
+		self.assertImagesEqual( s["r"]["out"], s["c"]["out"], ignoreMetadata = True )
+
 	def testDerivingInPython( self ) :
 
 		class DerivedImageWriter( GafferImage.ImageWriter ) :
@@ -1041,6 +1080,127 @@ class ImageWriterTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertEqual( r["out"]["metadata"].getValue()["test"], m["out"]["metadata"].getValue()["test"] )
 
+	def testTileRows( self ) :
+
+		# Offset the image so that neither the data window nor
+		# the display window line up with the Gaffer tiles, and
+		# check that rows of output tiles are all written correctly.
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.__negativeDataWindowFilePath + ".exr" )
+
+		o = GafferImage.Offset()
+		o["in"].setInput( r["out"] )
+		o["offset"].setValue( imath.V2i( 13, -21 ) )
+
+		w = GafferImage.ImageWriter()
+		w["in"].setInput( o["out"] )
+		w["openexr"]["mode"].setValue( GafferImage.ImageWriter.Mode.Tile )
+
+		result = GafferImage.ImageReader()
+
+		for compression in ( "none", "zip", "piz" ) :
+
+			testFile = os.path.join( self.temporaryDirectory(), "tileRows.{0}.exr".format( compression ) )
+			w["fileName"].setValue( testFile )
+			w["openexr"]["compression"].setValue( compression )
+			w["openexr"]["dataType"].setValue( "float" )
+
+			with Gaffer.Context() :
+				w["task"].execute()
+
+			result["fileName"].setValue( testFile )
+			self.assertImagesEqual( result["out"], o["out"], ignoreMetadata = True )
+
+	def testUnalignedDataWindowTileRows( self ) :
+
+		# Crop a data window spanning many rows of both Gaffer tiles
+		# and output tiles, with no edge aligned to either tile grid.
+		# The last output tile in each row overhangs the last Gaffer
+		# tile, and must still be flagged as filled so that every row
+		# is written out.
+
+		c = GafferImage.Checkerboard()
+		c["format"].setValue( GafferImage.Format( 512, 400 ) )
+		c["size"].setValue( imath.V2f( 13 ) )
+
+		crop = GafferImage.Crop()
+		crop["in"].setInput( c["out"] )
+		crop["area"].setValue( imath.Box2i( imath.V2i( 19, 7 ), imath.V2i( 421, 333 ) ) )
+		crop["affectDisplayWindow"].setValue( False )
+
+		w = GafferImage.ImageWriter()
+		w["in"].setInput( crop["out"] )
+		w["openexr"]["mode"].setValue( GafferImage.ImageWriter.Mode.Tile )
+		w["openexr"]["dataType"].setValue( "float" )
+		w["tiff"]["mode"].setValue( GafferImage.ImageWriter.Mode.Tile )
+		w["tiff"]["dataType"].setValue( "float" )
+
+		result = GafferImage.ImageReader()
+
+		for extension in ( "exr", "tif" ) :
+
+			testFile = os.path.join( self.temporaryDirectory(), "unalignedTileRows." + extension )
+			w["fileName"].setValue( testFile )
+
+			with Gaffer.Context() :
+				w["task"].execute()
+
+			result["fileName"].setValue( testFile )
+			self.assertEqual( result["out"]["dataWindow"].getValue(), crop["out"]["dataWindow"].getValue() )
+			self.assertImagesEqual( result["out"], crop["out"], ignoreMetadata = True )
+
+	def testTileRowsWrittenBeforeFinish( self ) :
+
+		# Make a tall image, one tile wide, in which each tile records
+		# the size of the output file at the time the tile is computed.
+		# Tiles are computed from the top down, so if rows are flushed
+		# as soon as they are complete, the bottom tile will see most
+		# of the image already on disk, well before the writer finishes.
+
+		testFile = os.path.join( self.temporaryDirectory(), "tileRowsWrittenBeforeFinish.exr" )
+		numRows = 512
+
+		s = Gaffer.ScriptNode()
+		s["c"] = GafferImage.Constant()
+		s["c"]["format"].setValue( GafferImage.Format( GafferImage.ImagePlug.tileSize(), GafferImage.ImagePlug.tileSize() * numRows ) )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( inspect.cleandoc(
+			"""
+			import os
+			# Depend on the tile origin, so we are evaluated once per tile.
+			tileOrigin = context["image:tileOrigin"]
+			fileName = {0}
+			parent["c"]["color"]["r"] = os.path.getsize( fileName ) if os.path.exists( fileName ) else -1
+			""".format( repr( testFile ) )
+		) )
+
+		s["w"] = GafferImage.ImageWriter()
+		s["w"]["in"].setInput( s["c"]["out"] )
+		s["w"]["fileName"].setValue( testFile )
+		s["w"]["channels"].setValue( "R" )
+		s["w"]["openexr"]["mode"].setValue( GafferImage.ImageWriter.Mode.Tile )
+		s["w"]["openexr"]["compression"].setValue( "none" )
+		s["w"]["openexr"]["dataType"].setValue( "float" )
+
+		with Gaffer.Context() :
+			s["w"]["task"].execute()
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( testFile )
+
+		sampler = GafferImage.Sampler( r["out"], "R", r["out"]["dataWindow"].getValue() )
+		topSize = sampler.sample( 0, GafferImage.ImagePlug.tileSize() * numRows - 1 )
+		bottomSize = sampler.sample( 0, 0 )
+
+		# At most one row per thread can be in flight at once, so
+		# at least half of the rows should have been written by the
+		# time the bottom row is computed.
+		rowSize = GafferImage.ImagePlug.tileSize() * GafferImage.ImagePlug.tileSize() * 4
+		self.assertLess( topSize, rowSize )
+		self.assertGreater( bottomSize, rowSize * numRows / 2 )
+
 	def __testFile( self, mode, channels, ext ) :
 
 		return self.temporaryDirectory() + "/test." + channels + "." + str( mode ) + "." + str( ext )
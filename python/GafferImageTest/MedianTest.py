@@ -35,11 +35,13 @@
 ##########################################################################
 
 import os
+import math
 import time
 import unittest
 import imath
 
 import IECore
+import IECoreImage
 
 import Gaffer
 import GafferTest
@@ -95,6 +97,40 @@ class MedianTest( GafferImageTest.ImageTestCase ) :
 			for x in range( dataWindow.min().x, dataWindow.max().x ) :
 				self.assertAlmostEqual( s.sample( x, y ), uMin + x * uStep, delta = 0.011 )
 
+	def testNaN( self ) :
+
+		values = [ float( "nan" ) ] + range( 1, 9 )
+		dataWindow = imath.Box2i( imath.V2i( 0 ), imath.V2i( 2 ) )
+		image = IECoreImage.ImagePrimitive( dataWindow, dataWindow )
+		image["R"] = IECore.FloatVectorData( values )
+
+		o = GafferImage.ObjectToImage()
+		o["object"].setValue( image )
+
+		m = GafferImage.Median()
+		m["in"].setInput( o["out"] )
+		m["radius"].setValue( imath.V2i( 1 ) )
+
+		# NaNs are ordered after all other values.
+
+		s = GafferImage.Sampler( m["out"], "R", m["out"]["dataWindow"].getValue() )
+		self.assertEqual( s.sample( 1, 1 ), 5 )
+
+		m["masterChannel"].setValue( "R" )
+		s = GafferImage.Sampler( m["out"], "R", m["out"]["dataWindow"].getValue() )
+		self.assertEqual( s.sample( 1, 1 ), 5 )
+		m["masterChannel"].setValue( "" )
+
+		# So the median is only NaN if more than
+		# half the window is NaN.
+
+		values[1:5] = [ float( "nan" ) ] * 4
+		image["R"] = IECore.FloatVectorData( values )
+		o["object"].setValue( image )
+
+		s = GafferImage.Sampler( m["out"], "R", m["out"]["dataWindow"].getValue() )
+		self.assertTrue( math.isnan( s.sample( 1, 1 ) ) )
+
 	def testDriverChannel( self ) :
 
 		rRaw = GafferImage.ImageReader()
@@ -143,6 +179,36 @@ class MedianTest( GafferImageTest.ImageTestCase ) :
 			# a master
 			self.assertImagesEqual( masterMedianSingleChannel["out"], defaultMedianSingleChannel["out"] )
 
+	def testMatchesDriverChannel( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( os.path.dirname( __file__ ) + "/images/circles.exr" )
+
+		# When the master channel is the only channel, the result must be
+		# the same as that computed by the faster default code path.
+
+		singleChannel = GafferImage.DeleteChannels()
+		singleChannel["in"].setInput( r["out"] )
+		singleChannel["mode"].setValue( GafferImage.DeleteChannels.Mode.Keep )
+		singleChannel["channels"].setValue( "G" )
+
+		masterMedian = GafferImage.Median()
+		masterMedian["in"].setInput( singleChannel["out"] )
+		masterMedian["masterChannel"].setValue( "G" )
+
+		defaultMedian = GafferImage.Median()
+		defaultMedian["in"].setInput( singleChannel["out"] )
+
+		for radius in [ imath.V2i( 1 ), imath.V2i( 3, 0 ), imath.V2i( 0, 2 ), imath.V2i( 5, 2 ) ] :
+			for boundingMode in [ GafferImage.Sampler.BoundingMode.Black, GafferImage.Sampler.BoundingMode.Clamp ] :
+				for expandDataWindow in [ False, True ] :
+					for n in [ masterMedian, defaultMedian ] :
+						n["radius"].setValue( radius )
+						n["boundingMode"].setValue( boundingMode )
+						n["expandDataWindow"].setValue( expandDataWindow )
+
+					self.assertImagesEqual( defaultMedian["out"], masterMedian["out"] )
+
 	def testCancellation( self ) :
 
 		c = GafferImage.Constant()
@@ -183,6 +183,29 @@ class ResampleTest( GafferImageTest.ImageTestCase ) :
 		r["filterScale"].setValue( imath.V2f( 10 ) )
 		self.assertEqual( r["out"]["dataWindow"].getValue(), imath.Box2i( d.min() - imath.V2i( 5 ), d.max() + imath.V2i( 5 ) ) )
 
+	def testSeparablePassesMatchSinglePass( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( os.path.dirname( __file__ ) + "/images/resamplePatterns.exr" )
+
+		separable = GafferImage.Resample()
+		separable["in"].setInput( r["out"] )
+
+		singlePass = GafferImage.Resample()
+		singlePass["in"].setInput( r["out"] )
+		singlePass["debug"].setValue( GafferImage.Resample.Debug.SinglePass )
+
+		for matrix in [
+			imath.M33f().scale( imath.V2f( 0.37, 2.5 ) ),
+			imath.M33f().translate( imath.V2f( 10.5, -3.25 ) ) * imath.M33f().scale( imath.V2f( 1.7, 0.6 ) ),
+		] :
+			for filter in [ "box", "triangle", "lanczos3", "blackman-harris" ] :
+				for resample in [ separable, singlePass ] :
+					resample["matrix"].setValue( matrix )
+					resample["filter"].setValue( filter )
+
+				self.assertImagesEqual( separable["out"], singlePass["out"], maxDifference = 0.0001 )
+
 	def testCancellation( self ) :
 
 		c = GafferImage.Constant()
@@ -113,6 +113,25 @@ class TextTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertImagesEqual( text["out"], reader["out"], ignoreMetadata = True, maxDifference = 0.001 )
 
+	def testWholePixelTranslation( self ) :
+
+		# Glyph bitmaps are cached independently of any whole pixel
+		# translation, so translated text should match exactly.
+
+		text1 = GafferImage.Text()
+		text1["text"].setValue( "Cached glyphs" )
+		text1["transform"]["translate"].setValue( imath.V2f( 0.25, 0.5 ) )
+
+		text2 = GafferImage.Text()
+		text2["text"].setValue( "Cached glyphs" )
+		text2["transform"]["translate"].setValue( imath.V2f( 21.25, -30.5 ) )
+
+		offset = GafferImage.Offset()
+		offset["in"].setInput( text1["out"] )
+		offset["offset"].setValue( imath.V2i( 21, -31 ) )
+
+		self.assertImagesEqual( text2["out"], offset["out"] )
+
 	def testHorizontalAlignment( self ) :
 
 		text = GafferImage.Text()
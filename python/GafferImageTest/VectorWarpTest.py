@@ -99,6 +99,32 @@ class VectorWarpTest( GafferImageTest.ImageTestCase ) :
 				sampler1["pixel"].setValue( imath.V2f( u * 2, v * 2 ) )
 				self.assertEqual( sampler1["color"].getValue(), sampler2["color"].getValue() )
 
+	def testFiltersMatchSampleBox( self ) :
+
+		reader = GafferImage.ImageReader()
+		reader["fileName"].setValue( os.path.dirname( __file__ ) + "/images/checker2x2.exr" )
+
+		constant = GafferImage.Constant()
+		constant["color"].setValue( imath.Color4f( 0.3, 0.6, 0, 1 ) )
+
+		vectorWarp = GafferImage.VectorWarp()
+		vectorWarp["in"].setInput( reader["out"] )
+		vectorWarp["vector"].setInput( constant["out"] )
+		vectorWarp["useDerivatives"].setValue( False )
+
+		sampler = GafferImage.Sampler( reader["out"], "R", imath.Box2i( imath.V2i( -10 ), imath.V2i( 10 ) ) )
+
+		# The filter weights are precomputed and shared between channels
+		# for separable filters, but results must match sampleBox() exactly
+		# for all filters.
+		for filter in GafferImage.FilterAlgo.filterNames() :
+			vectorWarp["filter"].setValue( filter )
+			self.assertAlmostEqual(
+				vectorWarp["out"].channelData( "R", imath.V2i( 0 ) )[0],
+				GafferImage.FilterAlgo.sampleBox( sampler, imath.V2f( 0.6, 1.2 ), 1, 1, filter ),
+				places = 6
+			)
+
 	def testNegativeDataWindowOrigin( self ) :
 
 		reader = GafferImage.ImageReader()
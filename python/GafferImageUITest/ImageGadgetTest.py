@@ -34,9 +34,13 @@
 #
 ##########################################################################
 
+import os
+import time
 import unittest
 import imath
 
+import IECore
+
 import Gaffer
 import GafferUI
 import GafferUITest
@@ -100,6 +104,55 @@ class ImageGadgetTest( GafferUITest.TestCase ) :
 		del g, w
 		del s
 
+	def __renderCentrePixel( self, image, frameBound ) :
+
+		g = GafferImageUI.ImageGadget()
+		g.setImage( image )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( g )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		gw.getViewportGadget().frame( frameBound )
+
+		t = time.time()
+		while g.state() != g.State.Complete and time.time() - t < 10 :
+			self.waitForIdle( 100 )
+
+		self.assertEqual( g.state(), g.State.Complete )
+		self.waitForIdle( 100 )
+
+		grabFile = os.path.join( self.temporaryDirectory(), "grab.png" )
+		GafferUI.WidgetAlgo.grab( gw, grabFile )
+		grab = IECore.Reader.create( grabFile ).read()
+
+		size = grab.dataWindow.size() + imath.V2i( 1 )
+		index = ( size.y // 2 ) * size.x + size.x // 2
+
+		del g, gw, w
+
+		return imath.Color3f( *[ grab[c][index] for c in ( "R", "G", "B" ) ] )
+
+	def testAtlasPages( self ) :
+
+		# Frame a small region of a large image, so that all tiles are
+		# computed at full resolution, and need several atlas pages.
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 2000, 2000 ) )
+		c["color"].setValue( imath.Color4f( 1, 0, 0, 1 ) )
+
+		frameBound = imath.Box3f( imath.V3f( 950, 950, 0 ), imath.V3f( 1050, 1050, 0 ) )
+		self.assertEqual( self.__renderCentrePixel( c["out"], frameBound ), imath.Color3f( 1, 0, 0 ) )
+
+		# Destroying the first gadget releases its pages. Check that
+		# a second gadget can allocate them again.
+
+		c["color"].setValue( imath.Color4f( 0, 1, 0, 1 ) )
+		self.assertEqual( self.__renderCentrePixel( c["out"], frameBound ), imath.Color3f( 0, 1, 0 ) )
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -99,6 +99,42 @@ class SceneWriterTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( t.readTransformAsMatrix( 1.5 / 24.0 ), imath.M44d().translate( imath.V3d( 1.5, 0, 3 ) ) )
 		self.assertEqual( t.readTransformAsMatrix( 2 / 24.0 ), imath.M44d().translate( imath.V3d( 2, 0, 4 ) ) )
 
+	def testWriteManyFrames( self ) :
+
+		# More frames than are computed concurrently, to check
+		# that they are still written in order.
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		script["group"] = GafferScene.Group()
+		script["group"]["in"][0].setInput( script["sphere"]["out"] )
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["group"]["transform"]["translate"]["x"] = context.getFrame()' )
+		script["writer"] = GafferScene.SceneWriter()
+		script["writer"]["in"].setInput( script["group"]["out"] )
+
+		self.assertEqual( script["writer"]["concurrentFrames"].getValue(), 1 )
+
+		frames = range( 1, 21 )
+		for concurrentFrames in ( 1, 4 ) :
+
+			fileName = self.temporaryDirectory() + "/test{0}.scc".format( concurrentFrames )
+			script["writer"]["fileName"].setValue( fileName )
+			script["writer"]["concurrentFrames"].setValue( concurrentFrames )
+
+			with Gaffer.Context() :
+				script["writer"].executeSequence( frames )
+
+			sc = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+			t = sc.child( "group" )
+
+			self.assertEqual( t.numTransformSamples(), len( frames ) )
+			for i, frame in enumerate( frames ) :
+				self.assertAlmostEqual( t.transformSampleTime( i ), frame / 24.0 )
+				self.assertEqual( t.readTransformAsMatrix( frame / 24.0 ), imath.M44d().translate( imath.V3d( frame, 0, 0 ) ) )
+
+			self.assertEqual( t.child( "sphere" ).numObjectSamples(), len( frames ) )
+
 	def testSceneCacheRoundtrip( self ) :
 
 		scene = IECoreScene.SceneCache( self.temporaryDirectory() + "/fromPython.scc", IECore.IndexedIO.OpenMode.Write )
@@ -92,6 +92,21 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"concurrentFrames" : [
+
+			"description",
+			"""
+			The number of frames to compute at the same time when
+			writing a sequence. Frames are still written to the file
+			in order. With the default of 1, each location is written
+			as soon as it has been computed, so memory usage stays low.
+			Higher values may speed up the writing of animated scenes,
+			but the data for the entire scene is held in memory for
+			each frame being computed.
+			""",
+
+		],
+
 	}
 
 )
@@ -44,8 +44,16 @@
 #include "IECore/FrameRange.h"
 #include "IECore/MessageHandler.h"
 
-#include "boost/algorithm/string/predicate.hpp"
 #include "boost/filesystem.hpp"
+#include "boost/filesystem/fstream.hpp"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
 
 using namespace IECore;
 using namespace Gaffer;
@@ -59,6 +67,8 @@ static InternedString g_immediateBlindDataName( "dispatcher:immediate" );
 static InternedString g_sizeBlindDataName( "dispatcher:size" );
 static InternedString g_executedBlindDataName( "dispatcher:executed" );
 static InternedString g_visitedBlindDataName( "dispatcher:visited" );
+static InternedString g_hashFileBlindDataName( "dispatcher:hashFile" );
+static InternedString g_timingFileBlindDataName( "dispatcher:timingFile" );
 static InternedString g_jobDirectoryContextEntry( "dispatcher:jobDirectory" );
 static IECore::BoolDataPtr g_trueBoolData = new BoolData( true );
 
@@ -79,6 +89,8 @@ Dispatcher::Dispatcher( const std::string &name )
 	addChild( new StringPlug( "frameRange", Plug::In, "1-100x10" ) );
 	addChild( new StringPlug( "jobName", Plug::In, "" ) );
 	addChild( new StringPlug( "jobsDirectory", Plug::In, "" ) );
+	addChild( new BoolPlug( "skipUnchangedTasks", Plug::In, false ) );
+	addChild( new FloatPlug( "targetBatchDuration", Plug::In, 0.0f, 0.0f ) );
 }
 
 Dispatcher::~Dispatcher()
@@ -125,6 +137,26 @@ const StringPlug *Dispatcher::jobsDirectoryPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 3 );
 }
 
+BoolPlug *Dispatcher::skipUnchangedTasksPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
+const BoolPlug *Dispatcher::skipUnchangedTasksPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
+FloatPlug *Dispatcher::targetBatchDurationPlug()
+{
+	return getChild<FloatPlug>( g_firstPlugIndex + 5 );
+}
+
+const FloatPlug *Dispatcher::targetBatchDurationPlug() const
+{
+	return getChild<FloatPlug>( g_firstPlugIndex + 5 );
+}
+
 const std::string Dispatcher::jobDirectory() const
 {
 	return m_jobDirectory;
@@ -272,7 +304,30 @@ void Dispatcher::TaskBatch::execute() const
 	}
 
 	Context::Scope scopedContext( m_context.get() );
+	const auto startTime = std::chrono::steady_clock::now();
 	m_plug->executeSequence( m_frames );
+	const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+	if( const StringData *hashFile = m_blindData->member<StringData>( g_hashFileBlindDataName ) )
+	{
+		// Record the successful execution, so that future dispatches
+		// using `skipUnchangedTasks` can skip this batch.
+		boost::filesystem::ofstream( hashFile->readable() );
+	}
+
+	if( const StringData *timingFile = m_blindData->member<StringData>( g_timingFileBlindDataName ) )
+	{
+		// Record the time taken per frame, so that future dispatches
+		// using `targetBatchDuration` can size their batches. Batches
+		// for the same node may finish concurrently, so we write to a
+		// temporary file and rename it, to ensure that readers never
+		// see a partially written file.
+		const boost::filesystem::path tempFile = boost::filesystem::unique_path( timingFile->readable() + ".%%%%-%%%%-%%%%-%%%%" );
+		{
+			boost::filesystem::ofstream( tempFile ) << duration.count() / m_frames.size();
+		}
+		boost::filesystem::rename( tempFile, timingFile->readable() );
+	}
 }
 
 const TaskNode::TaskPlug *Dispatcher::TaskBatch::plug() const
@@ -332,13 +387,59 @@ class Dispatcher::Batcher
 	public :
 
 		Batcher()
-			:	m_rootBatch( new TaskBatch() )
+			:	m_rootBatch( new TaskBatch() ), m_targetBatchDuration( 0.0f )
+		{
+		}
+
+		// Enables automatic batch sizing, using the per-frame execution
+		// times recorded in `timingDirectory` by previous dispatches.
+		// Must be called before `addTasks()`.
+		void setTargetBatchDuration( float targetBatchDuration, const boost::filesystem::path &timingDirectory )
 		{
+			m_targetBatchDuration = targetBatchDuration;
+			m_timingDirectory = timingDirectory;
 		}
 
-		void addTask( const TaskNode::Task &task )
+		void addTasks( const std::vector<TaskNodePtr> &taskNodes, const std::vector<FrameList::Frame> &frames, Context::EditableScope &frameScope )
 		{
-			addPreTask( m_rootBatch.get(), batchTasksWalk( task ) );
+			// Computing task hashes and querying preTasks and postTasks is
+			// the expensive part of batching, and is independent for each
+			// frame, so we gather descriptions of all the tasks in parallel.
+
+			const Context *context = Context::current();
+			std::vector<TaskDescriptions> descriptions( frames.size() );
+			std::vector<TaskDescriptionMap> descriptionMaps( frames.size() );
+
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, frames.size() ),
+				[&]( const tbb::blocked_range<size_t> &range ) {
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						ContextPtr frameContext = new Context( *context );
+						frameContext->setFrame( frames[i] );
+						for( const auto &taskNode : taskNodes )
+						{
+							descriptions[i].push_back(
+								describeTask( TaskNode::Task( taskNode->taskPlug(), frameContext.get() ), descriptionMaps[i] )
+							);
+						}
+					}
+				},
+				taskGroupContext
+			);
+
+			// Batching itself must be done serially, in the order the
+			// tasks were requested, so that batches are deterministic.
+
+			for( size_t i = 0; i < frames.size(); ++i )
+			{
+				frameScope.setFrame( frames[i] );
+				for( const auto &description : descriptions[i] )
+				{
+					addPreTask( m_rootBatch.get(), batchTasksWalk( description ) );
+				}
+			}
 		}
 
 		TaskBatch *rootBatch()
@@ -346,19 +447,55 @@ class Dispatcher::Batcher
 			return m_rootBatch.get();
 		}
 
+		// Removes batches which were successfully executed by a previous
+		// dispatch, as recorded by files in `hashDirectory`, and records
+		// the hash file for each remaining batch in its blind data.
+		void pruneUnchangedBatches( const boost::filesystem::path &hashDirectory )
+		{
+			UnchangedMap visited;
+			pruneUnchangedWalk( m_rootBatch.get(), hashDirectory, visited );
+		}
+
 	private :
 
-		TaskBatchPtr batchTasksWalk( const TaskNode::Task &task, const std::set<const TaskBatch *> &ancestors = std::set<const TaskBatch *>() )
+		// A task along with the descriptions of its preTasks
+		// and postTasks, gathered by `describeTask()`.
+		struct TaskDescription
 		{
-			// Acquire a batch with this task placed in it,
-			// and check that we haven't discovered a cyclic
-			// dependency.
-			TaskBatchPtr batch = acquireBatch( task );
-			if( ancestors.find( batch.get() ) != ancestors.end() )
+			TaskDescription( const TaskNode::Task &task )
+				:	task( task )
 			{
-				throw IECore::Exception( ( boost::format( "Dispatched tasks cannot have cyclic dependencies but %s is involved in a cycle." ) % batch->plug()->relativeName( batch->plug()->ancestor<ScriptNode>() ) ).str() );
 			}
 
+			TaskNode::Task task;
+			IECore::MurmurHash batchHash;
+			std::vector<const TaskDescription *> preTasks;
+			std::vector<const TaskDescription *> postTasks;
+		};
+
+		typedef std::vector<const TaskDescription *> TaskDescriptions;
+		// Owns the descriptions for a single frame, keyed by task plug and context hash.
+		typedef std::map<std::pair<const TaskNode::TaskPlug *, IECore::MurmurHash>, std::unique_ptr<TaskDescription>> TaskDescriptionMap;
+
+		const TaskDescription *describeTask( const TaskNode::Task &task, TaskDescriptionMap &descriptionMap ) const
+		{
+			// The same task is often reached by many paths through the
+			// graph, so we memoise the descriptions to avoid repeatedly
+			// querying its preTasks and hashing them. The description is
+			// registered before visiting the preTasks so that cyclic
+			// dependencies terminate here, leaving `batchTasksWalk()`
+			// to report them.
+			const TaskDescriptionMap::key_type key( task.plug(), task.context()->hash() );
+			TaskDescriptionMap::const_iterator it = descriptionMap.find( key );
+			if( it != descriptionMap.end() )
+			{
+				return it->second.get();
+			}
+
+			TaskDescription *description = new TaskDescription( task );
+			descriptionMap[key].reset( description );
+			description->batchHash = batchHash( task );
+
 			// Ask the task what preTasks and postTasks it would like.
 			TaskNode::Tasks preTasks;
 			TaskNode::Tasks postTasks;
@@ -368,12 +505,98 @@ class Dispatcher::Batcher
 				task.plug()->postTasks( postTasks );
 			}
 
+			for( const auto &preTask : preTasks )
+			{
+				description->preTasks.push_back( describeTask( preTask, descriptionMap ) );
+			}
+			for( const auto &postTask : postTasks )
+			{
+				description->postTasks.push_back( describeTask( postTask, descriptionMap ) );
+			}
+
+			return description;
+		}
+
+		struct Unchanged
+		{
+			bool unchanged;
+			// Identifies the tasks in the batch, and in all
+			// its upstream batches.
+			IECore::MurmurHash hash;
+		};
+
+		typedef std::map<const TaskBatch *, Unchanged> UnchangedMap;
+
+		const Unchanged &pruneUnchangedWalk( TaskBatch *batch, const boost::filesystem::path &hashDirectory, UnchangedMap &visited )
+		{
+			UnchangedMap::const_iterator vIt = visited.find( batch );
+			if( vIt != visited.end() )
+			{
+				return vIt->second;
+			}
+
+			Unchanged result;
+			// The root batch has no plug, and must always remain.
+			result.unchanged = batch->plug() != nullptr;
+			BatchTaskHashes::const_iterator hIt = m_batchTaskHashes.find( batch );
+			if( hIt != m_batchTaskHashes.end() )
+			{
+				result.hash = hIt->second;
+			}
+
+			TaskBatches &preTasks = batch->preTasks();
+			for( TaskBatches::iterator it = preTasks.begin(); it != preTasks.end(); )
+			{
+				const Unchanged &preTaskUnchanged = pruneUnchangedWalk( it->get(), hashDirectory, visited );
+				result.hash.append( preTaskUnchanged.hash );
+				if( preTaskUnchanged.unchanged )
+				{
+					it = preTasks.erase( it );
+				}
+				else
+				{
+					result.unchanged = false;
+					++it;
+				}
+			}
+
+			// Batches without frames are no-ops, so there is no record of
+			// their execution, and they are unchanged if their preTasks are.
+			// Tasks whose hash doesn't cover all their inputs can't be
+			// known to be unchanged, so are always executed, along with
+			// everything downstream of them.
+			if( batch->plug() && !batch->frames().empty() )
+			{
+				if( !batch->plug()->hashCoversInputs() )
+				{
+					result.unchanged = false;
+					return visited[batch] = result;
+				}
+				const boost::filesystem::path hashFile = hashDirectory / result.hash.toString();
+				result.unchanged = result.unchanged && boost::filesystem::exists( hashFile );
+				batch->blindData()->writable()[g_hashFileBlindDataName] = new StringData( hashFile.string() );
+			}
+
+			return visited[batch] = result;
+		}
+
+		TaskBatchPtr batchTasksWalk( const TaskDescription *description, const std::set<const TaskBatch *> &ancestors = std::set<const TaskBatch *>() )
+		{
+			// Acquire a batch with this task placed in it,
+			// and check that we haven't discovered a cyclic
+			// dependency.
+			TaskBatchPtr batch = acquireBatch( description );
+			if( ancestors.find( batch.get() ) != ancestors.end() )
+			{
+				throw IECore::Exception( ( boost::format( "Dispatched tasks cannot have cyclic dependencies but %s is involved in a cycle." ) % batch->plug()->relativeName( batch->plug()->ancestor<ScriptNode>() ) ).str() );
+			}
+
 			// Collect all the batches the postTasks belong in.
 			// We grab these first because they need to be included
 			// in the ancestors for cycle detection when getting
 			// the preTask batches.
 			TaskBatches postBatches;
-			for( TaskNode::Tasks::const_iterator it = postTasks.begin(); it != postTasks.end(); ++it )
+			for( TaskDescriptions::const_iterator it = description->postTasks.begin(); it != description->postTasks.end(); ++it )
 			{
 				postBatches.push_back( batchTasksWalk( *it ) );
 			}
@@ -388,7 +611,7 @@ class Dispatcher::Batcher
 				preTaskAncestors.insert( it->get() );
 			}
 
-			for( TaskNode::Tasks::const_iterator it = preTasks.begin(); it != preTasks.end(); ++it )
+			for( TaskDescriptions::const_iterator it = description->preTasks.begin(); it != description->preTasks.end(); ++it )
 			{
 				addPreTask( batch.get(), batchTasksWalk( *it, preTaskAncestors ) );
 			}
@@ -407,8 +630,10 @@ class Dispatcher::Batcher
 			return batch;
 		}
 
-		TaskBatchPtr acquireBatch( const TaskNode::Task &task )
+		TaskBatchPtr acquireBatch( const TaskDescription *description )
 		{
+			const TaskNode::Task &task = description->task;
+
 			// See if we've previously visited this task, and therefore
 			// have placed it in a batch already, which we can return
 			// unchanged. The `taskToBatchMapHash` is used as the unique
@@ -421,7 +646,7 @@ class Dispatcher::Batcher
 			{
 				// Prevent no-ops from coalescing into a single batch, as this
 				// would break parallelism - see `DispatcherTest.testNoOpDoesntBreakFrameParallelism()`
-				taskToBatchMapHash.append( contextHash( task.context() ) );
+				taskToBatchMapHash.append( task.context()->hash() );
 			}
 			const TaskToBatchMap::const_iterator it = m_tasksToBatches.find( taskToBatchMapHash );
 			if( it != m_tasksToBatches.end() )
@@ -437,7 +662,7 @@ class Dispatcher::Batcher
 			const bool requiresSequenceExecution = task.plug()->requiresSequenceExecution();
 
 			TaskBatchPtr batch = nullptr;
-			const MurmurHash batchMapHash = batchHash( task );
+			const MurmurHash &batchMapHash = description->batchHash;
 			BatchMap::iterator bIt = m_currentBatches.find( batchMapHash );
 			if( bIt != m_currentBatches.end() )
 			{
@@ -445,9 +670,7 @@ class Dispatcher::Batcher
 				// Unfortunately we have to track batch size separately from `batch->frames().size()`,
 				// because no-ops don't update `frames()`, but _do_ count towards batch size.
 				IntDataPtr batchSizeData = candidateBatch->blindData()->member<IntData>( g_sizeBlindDataName );
-				const IntPlug *batchSizePlug = task.node()->dispatcherPlug()->getChild<const IntPlug>( g_batchSize );
-				const int batchSizeLimit = ( batchSizePlug ) ? batchSizePlug->getValue() : 1;
-				if( requiresSequenceExecution || ( batchSizeData->readable() < batchSizeLimit ) )
+				if( requiresSequenceExecution || ( batchSizeData->readable() < batchSizeLimit( task, batchMapHash ) ) )
 				{
 					batch = candidateBatch;
 					batchSizeData->writable()++;
@@ -458,6 +681,10 @@ class Dispatcher::Batcher
 			{
 				batch = new TaskBatch( task.plug(), task.context() );
 				batch->blindData()->writable()[g_sizeBlindDataName] = new IntData( 1 );
+				if( m_targetBatchDuration > 0.0f )
+				{
+					batch->blindData()->writable()[g_timingFileBlindDataName] = new StringData( timingFile( task.node() ).string() );
+				}
 				m_currentBatches[batchMapHash] = batch;
 			}
 
@@ -466,6 +693,7 @@ class Dispatcher::Batcher
 
 			if( task.hash() != MurmurHash() )
 			{
+				m_batchTaskHashes[batch.get()].append( task.hash() );
 				float frame = task.context()->getFrame();
 				std::vector<float> &frames = batch->frames();
 				if( requiresSequenceExecution )
@@ -495,41 +723,65 @@ class Dispatcher::Batcher
 			return batch;
 		}
 
+		int batchSizeLimit( const TaskNode::Task &task, const IECore::MurmurHash &batchHash )
+		{
+			const TaskNode *node = task.node();
+			const IntPlug *batchSizePlug = node->dispatcherPlug()->getChild<const IntPlug>( g_batchSize );
+			int batchSize = 1;
+			if( batchSizePlug )
+			{
+				Context::Scope taskScope( task.context() );
+				batchSize = batchSizePlug->getValue();
+			}
+			if( m_targetBatchDuration <= 0.0f || !batchSizePlug )
+			{
+				return batchSize;
+			}
+
+			// The batch size may vary with context, so we cache the result
+			// per batch rather than per node.
+			AutomaticBatchSizes::const_iterator it = m_automaticBatchSizes.find( batchHash );
+			if( it != m_automaticBatchSizes.end() )
+			{
+				return it->second;
+			}
+
+			// Nodes which haven't been executed before fall back to their
+			// own batch size, and the time recorded when executing them will
+			// be used to size the batches of subsequent dispatches.
+			int result = batchSize;
+			boost::filesystem::ifstream file( timingFile( node ) );
+			double secondsPerFrame = 0;
+			if( file >> secondsPerFrame && secondsPerFrame > 0 )
+			{
+				const double frames = std::round( m_targetBatchDuration / secondsPerFrame );
+				result = (int)std::max( 1.0, std::min( frames, (double)std::numeric_limits<int>::max() ) );
+			}
+
+			m_automaticBatchSizes[batchHash] = result;
+			return result;
+		}
+
+		boost::filesystem::path timingFile( const TaskNode *node ) const
+		{
+			return m_timingDirectory / node->relativeName( node->scriptNode() );
+		}
+
 		// Hash used to determine how to coalesce tasks into batches.
 		// If `batchHash( task1 ) == batchHash( task2 )` then the two
 		// tasks can be placed in the same batch.
-		IECore::MurmurHash batchHash( const TaskNode::Task &task )
+		IECore::MurmurHash batchHash( const TaskNode::Task &task ) const
 		{
 			MurmurHash result;
 			result.append( (uint64_t)task.node() );
 			// We ignore the frame because the whole point of batching
 			// is to allow multiple frames to be placed in the same
-			// batch if the context is otherwise identical.
-			result.append( contextHash( task.context(), /* ignoreFrame = */ true ) );
-			return result;
-		}
-
-		IECore::MurmurHash contextHash( const Context *context, bool ignoreFrame = false ) const
-		{
-			IECore::MurmurHash result;
-			std::vector<IECore::InternedString> names;
-			context->names( names );
-			for( std::vector<IECore::InternedString>::const_iterator it = names.begin(); it != names.end(); ++it )
-			{
-				// Ignore the UI values since they should be irrelevant
-				// to execution.
-				if( boost::starts_with( it->string(), "ui:" ) )
-				{
-					continue;
-				}
-				if( ignoreFrame && *it == g_frame )
-				{
-					continue;
-				}
-
-				result.append( *it );
-				context->get<const IECore::Data>( *it )->hash( result );
-			}
+			// batch if the context is otherwise identical. Note that
+			// `Context::hash()` already ignores the UI values, since
+			// they should be irrelevant to execution.
+			Context::EditableScope framelessScope( task.context() );
+			framelessScope.remove( g_frame );
+			result.append( Context::current()->hash() );
 			return result;
 		}
 
@@ -566,9 +818,17 @@ class Dispatcher::Batcher
 		typedef std::map<IECore::MurmurHash, TaskBatchPtr> BatchMap;
 		typedef std::map<IECore::MurmurHash, TaskBatchPtr> TaskToBatchMap;
 
+		typedef std::map<const TaskBatch *, IECore::MurmurHash> BatchTaskHashes;
+		typedef std::map<IECore::MurmurHash, int> AutomaticBatchSizes;
+
 		TaskBatchPtr m_rootBatch;
 		BatchMap m_currentBatches;
 		TaskToBatchMap m_tasksToBatches;
+		BatchTaskHashes m_batchTaskHashes;
+
+		float m_targetBatchDuration;
+		boost::filesystem::path m_timingDirectory;
+		AutomaticBatchSizes m_automaticBatchSizes;
 
 };
 
@@ -683,13 +943,20 @@ void Dispatcher::dispatch( const std::vector<NodePtr> &nodes ) const
 	frameList->asList( frames );
 
 	Batcher batcher;
-	for( std::vector<FrameList::Frame>::const_iterator fIt = frames.begin(); fIt != frames.end(); ++fIt )
+	const float targetBatchDuration = targetBatchDurationPlug()->getValue();
+	if( targetBatchDuration > 0.0f )
 	{
-		for( std::vector<TaskNodePtr>::const_iterator nIt = taskNodes.begin(); nIt != taskNodes.end(); ++nIt )
-		{
-			jobScope.setFrame( *fIt );
-			batcher.addTask( TaskNode::Task( *nIt, Context::current() ) );
-		}
+		const boost::filesystem::path timingDirectory = boost::filesystem::path( m_jobDirectory ).parent_path() / "taskTimings";
+		boost::filesystem::create_directories( timingDirectory );
+		batcher.setTargetBatchDuration( targetBatchDuration, timingDirectory );
+	}
+	batcher.addTasks( taskNodes, frames, jobScope );
+
+	if( skipUnchangedTasksPlug()->getValue() )
+	{
+		const boost::filesystem::path hashDirectory = boost::filesystem::path( m_jobDirectory ).parent_path() / "taskHashes";
+		boost::filesystem::create_directories( hashDirectory );
+		batcher.pruneUnchangedBatches( hashDirectory );
 	}
 
 	executeAndPruneImmediateBatches( batcher.rootBatch() );
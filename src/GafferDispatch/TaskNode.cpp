@@ -136,6 +136,7 @@ class TaskNodeProcess : public Gaffer::Process
 		static InternedString executeProcessType;
 		static InternedString executeSequenceProcessType;
 		static InternedString requiresSequenceExecutionProcessType;
+		static InternedString hashCoversInputsProcessType;
 		static InternedString preTasksProcessType;
 		static InternedString postTasksProcessType;
 
@@ -145,6 +146,7 @@ InternedString TaskNodeProcess::hashProcessType( "taskNode:hash" );
 InternedString TaskNodeProcess::executeProcessType( "taskNode:execute" );
 InternedString TaskNodeProcess::executeSequenceProcessType( "taskNode:executeSequence" );
 InternedString TaskNodeProcess::requiresSequenceExecutionProcessType( "taskNode:requiresSequenceExecution" );
+InternedString TaskNodeProcess::hashCoversInputsProcessType( "taskNode:hashCoversInputs" );
 InternedString TaskNodeProcess::preTasksProcessType( "taskNode:preTasks" );
 InternedString TaskNodeProcess::postTasksProcessType( "taskNode:postTasks" );
 
@@ -265,6 +267,20 @@ bool TaskNode::TaskPlug::requiresSequenceExecution() const
 	}
 }
 
+bool TaskNode::TaskPlug::hashCoversInputs() const
+{
+	TaskNodeProcess p( TaskNodeProcess::hashCoversInputsProcessType, this );
+	try
+	{
+		return p.taskNode()->hashCoversInputs();
+	}
+	catch( ... )
+	{
+		p.handleException();
+		return false;
+	}
+}
+
 void TaskNode::TaskPlug::preTasks( Tasks &tasks ) const
 {
 	TaskNodeProcess p( TaskNodeProcess::preTasksProcessType, this );
@@ -439,3 +455,8 @@ bool TaskNode::requiresSequenceExecution() const
 {
 	return false;
 }
+
+bool TaskNode::hashCoversInputs() const
+{
+	return false;
+}
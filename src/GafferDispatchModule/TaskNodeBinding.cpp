@@ -170,6 +170,7 @@ void GafferDispatchModule::bindTaskNode()
 		.def( "execute", &taskPlugExecute )
 		.def( "executeSequence", &taskPlugExecuteSequence )
 		.def( "requiresSequenceExecution", &TaskNode::TaskPlug::requiresSequenceExecution )
+		.def( "hashCoversInputs", &TaskNode::TaskPlug::hashCoversInputs )
 		.def( "preTasks", &taskPlugPreTasks )
 		.def( "postTasks", &taskPlugPostTasks )
 		// Adjusting the name so that it correctly reflects
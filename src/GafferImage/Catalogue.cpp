@@ -36,6 +36,7 @@
 
 #include "GafferImage/Catalogue.h"
 
+#include "GafferImage/BufferAlgo.h"
 #include "GafferImage/Constant.h"
 #include "GafferImage/CopyChannels.h"
 #include "GafferImage/Display.h"
@@ -46,11 +47,13 @@
 #include "GafferImage/Text.h"
 
 #include "Gaffer/ArrayPlug.h"
+#include "Gaffer/BackgroundTask.h"
 #include "Gaffer/Context.h"
 #include "Gaffer/DownstreamIterator.h"
 #include "Gaffer/ParallelAlgo.h"
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/UndoScope.h"
 
 #include "boost/algorithm/string.hpp"
 #include "boost/bind.hpp"
@@ -59,8 +62,15 @@
 #include "boost/lexical_cast.hpp"
 #include "boost/unordered_map.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <thread>
 
+#include <zlib.h>
+
 using namespace std;
 using namespace IECore;
 using namespace Gaffer;
@@ -82,6 +92,264 @@ size_t hash_value( const Imath::V2i &v )
 
 IMATH_INTERNAL_NAMESPACE_HEADER_EXIT
 
+//////////////////////////////////////////////////////////////////////////
+// CompressedImage.
+// This node type holds an in-memory copy of an image, with each tile
+// compressed losslessly. It is used in place of Display nodes to reduce
+// the memory used by images which aren't being viewed.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Constant tiles are very common (think of alpha channels and the black
+// regions of renders), so we store them as a single value. All other tiles
+// are shuffled into byte planes, so that the similar high order bytes of
+// neighbouring pixels are adjacent, and then compressed with zlib.
+void compressTile( const vector<float> &tile, vector<unsigned char> &compressed )
+{
+	if( std::adjacent_find( tile.begin(), tile.end(), std::not_equal_to<float>() ) == tile.end() )
+	{
+		compressed.resize( sizeof( float ) );
+		memcpy( compressed.data(), tile.data(), sizeof( float ) );
+		return;
+	}
+
+	vector<unsigned char> shuffled( tile.size() * sizeof( float ) );
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>( tile.data() );
+	for( size_t i = 0, e = tile.size(); i < e; ++i )
+	{
+		for( size_t b = 0; b < sizeof( float ); ++b )
+		{
+			shuffled[b * e + i] = bytes[i * sizeof( float ) + b];
+		}
+	}
+
+	uLongf compressedSize = compressBound( shuffled.size() );
+	compressed.resize( compressedSize );
+	if( compress2( compressed.data(), &compressedSize, shuffled.data(), shuffled.size(), Z_BEST_SPEED ) != Z_OK )
+	{
+		throw IECore::Exception( "Failed to compress tile" );
+	}
+	compressed.resize( compressedSize );
+	compressed.shrink_to_fit();
+}
+
+ConstFloatVectorDataPtr decompressTile( const vector<unsigned char> &compressed )
+{
+	const size_t numPixels = ImagePlug::tileSize() * ImagePlug::tileSize();
+
+	FloatVectorDataPtr resultData = new FloatVectorData;
+	vector<float> &result = resultData->writable();
+
+	if( compressed.size() == sizeof( float ) )
+	{
+		// A zlib stream is always larger than this,
+		// so this must be a constant tile.
+		float value;
+		memcpy( &value, compressed.data(), sizeof( float ) );
+		result.resize( numPixels, value );
+		return resultData;
+	}
+
+	vector<unsigned char> shuffled( numPixels * sizeof( float ) );
+	uLongf shuffledSize = shuffled.size();
+	if(
+		uncompress( shuffled.data(), &shuffledSize, compressed.data(), compressed.size() ) != Z_OK ||
+		shuffledSize != shuffled.size()
+	)
+	{
+		throw IECore::Exception( "Failed to decompress tile" );
+	}
+
+	result.resize( numPixels );
+	unsigned char *bytes = reinterpret_cast<unsigned char *>( result.data() );
+	for( size_t i = 0; i < numPixels; ++i )
+	{
+		for( size_t b = 0; b < sizeof( float ); ++b )
+		{
+			bytes[i * sizeof( float ) + b] = shuffled[b * numPixels + i];
+		}
+	}
+
+	return resultData;
+}
+
+class CompressedImage : public ImageNode
+{
+
+	public :
+
+		CompressedImage( const std::string &name = "CompressedImage" )
+			:	ImageNode( name )
+		{
+		}
+
+		struct Data
+		{
+
+			Format format;
+			Imath::Box2i dataWindow;
+			ConstCompoundDataPtr metadata;
+			ConstStringVectorDataPtr channelNames;
+
+			// We reuse the hashes from the original image, so that
+			// any cache entries it made remain valid for us.
+			IECore::MurmurHash formatHash;
+			IECore::MurmurHash dataWindowHash;
+			IECore::MurmurHash metadataHash;
+			IECore::MurmurHash channelNamesHash;
+
+			struct Tile
+			{
+				vector<unsigned char> compressedData;
+				IECore::MurmurHash hash;
+			};
+
+			typedef std::pair<std::string, Imath::V2i> TileIndex;
+			typedef boost::unordered_map<TileIndex, Tile> Tiles;
+			Tiles tiles;
+
+			size_t memoryUsage;
+
+		};
+
+		typedef std::shared_ptr<const Data> ConstDataPtr;
+
+		static ConstDataPtr compress( const ImagePlug *image )
+		{
+			std::shared_ptr<Data> data = std::make_shared<Data>();
+
+			{
+				ImagePlug::GlobalScope globalScope( Context::current() );
+				data->formatHash = image->formatPlug()->hash();
+				data->format = image->formatPlug()->getValue();
+				data->dataWindowHash = image->dataWindowPlug()->hash();
+				data->dataWindow = image->dataWindowPlug()->getValue();
+				data->metadataHash = image->metadataPlug()->hash();
+				data->metadata = image->metadataPlug()->getValue();
+				data->channelNamesHash = image->channelNamesPlug()->hash();
+				data->channelNames = image->channelNamesPlug()->getValue();
+			}
+
+			data->memoryUsage = sizeof( Data );
+			ImageAlgo::parallelGatherTiles(
+				image,
+				data->channelNames->readable(),
+				// Tile
+				[] ( const ImagePlug *imagePlug, const string &channelName, const Imath::V2i &tileOrigin )
+				{
+					Data::Tile tile;
+					tile.hash = imagePlug->channelDataPlug()->hash();
+					ConstFloatVectorDataPtr channelData = imagePlug->channelDataPlug()->getValue( &tile.hash );
+					compressTile( channelData->readable(), tile.compressedData );
+					return tile;
+				},
+				// Gather
+				[ &data ] ( const ImagePlug *imagePlug, const string &channelName, const Imath::V2i &tileOrigin, Data::Tile &tile )
+				{
+					data->memoryUsage += tile.compressedData.size() + sizeof( Data::Tile );
+					data->tiles[Data::TileIndex( channelName, tileOrigin )] = std::move( tile );
+				}
+			);
+
+			return data;
+		}
+
+		void setData( ConstDataPtr data )
+		{
+			m_data = data;
+		}
+
+		const ConstDataPtr &getData() const
+		{
+			return m_data;
+		}
+
+	protected :
+
+		void hashFormat( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const override
+		{
+			h = m_data->formatHash;
+		}
+
+		GafferImage::Format computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const override
+		{
+			return m_data->format;
+		}
+
+		void hashDataWindow( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const override
+		{
+			h = m_data->dataWindowHash;
+		}
+
+		Imath::Box2i computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const override
+		{
+			return m_data->dataWindow;
+		}
+
+		void hashMetadata( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const override
+		{
+			h = m_data->metadataHash;
+		}
+
+		IECore::ConstCompoundDataPtr computeMetadata( const Gaffer::Context *context, const ImagePlug *parent ) const override
+		{
+			return m_data->metadata;
+		}
+
+		void hashChannelNames( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const override
+		{
+			h = m_data->channelNamesHash;
+		}
+
+		IECore::ConstStringVectorDataPtr computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const override
+		{
+			return m_data->channelNames;
+		}
+
+		void hashChannelData( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const override
+		{
+			Data::Tiles::const_iterator it = m_data->tiles.find(
+				Data::TileIndex(
+					context->get<string>( ImagePlug::channelNameContextName ),
+					context->get<Imath::V2i>( ImagePlug::tileOriginContextName )
+				)
+			);
+			if( it != m_data->tiles.end() )
+			{
+				h = it->second.hash;
+			}
+			else
+			{
+				h = ImagePlug::blackTile()->Object::hash();
+			}
+		}
+
+		IECore::ConstFloatVectorDataPtr computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const override
+		{
+			// Tiles are only decompressed when they are needed, and
+			// the decompressed data is then held in the compute cache.
+			Data::Tiles::const_iterator it = m_data->tiles.find( Data::TileIndex( channelName, tileOrigin ) );
+			if( it != m_data->tiles.end() )
+			{
+				return decompressTile( it->second.compressedData );
+			}
+			return ImagePlug::blackTile();
+		}
+
+	private :
+
+		ConstDataPtr m_data;
+
+};
+
+IE_CORE_DECLAREPTR( CompressedImage )
+
+const InternedString g_compressedImageName( "__compressedImage" );
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // InternalImage.
 // This node type provides the internal implementation of the images
@@ -94,7 +362,7 @@ class Catalogue::InternalImage : public ImageNode
 	public :
 
 		InternalImage( const std::string &name = "InternalImage" )
-			:	ImageNode( name ), m_clientPID( -1 ), m_numDriversClosed( 0 )
+			:	ImageNode( name ), m_clientPID( -1 ), m_acceptingDrivers( true ), m_compressible( true ), m_numDriversClosed( 0 )
 		{
 			storeIndexOfNextChild( g_firstChildIndex );
 
@@ -177,7 +445,13 @@ class Catalogue::InternalImage : public ImageNode
 			imageSwitch()->indexPlug()->setValue( other->imageSwitch()->indexPlug()->getValue() );
 			text()->enabledPlug()->setValue( other->text()->enabledPlug()->getValue() );
 
+			// Cancel any compression in progress, since it is for
+			// the image we are about to replace.
+			m_compressor = nullptr;
 			removeDisplays();
+			const CompressedImage *otherCompressedImage = other->compressedImage();
+			setCompressedData( otherCompressedImage ? otherCompressedImage->getData() : nullptr );
+
 			size_t numDisplays = 0;
 			for( DisplayIterator it( other ); !it.done(); ++it )
 			{
@@ -199,7 +473,11 @@ class Catalogue::InternalImage : public ImageNode
 				m_saver = AsynchronousSaver::create( this );
 			}
 
-			m_clientPID = -2; // Make sure insertDriver() will reject new drivers
+			m_acceptingDrivers = false;
+			// The Display nodes we have just added or removed may be
+			// part of the undo queue, so we must never remove them
+			// without undo. See `compress()`.
+			m_compressible = false;
 		}
 
 		void save( const std::string &fileName ) const
@@ -212,9 +490,9 @@ class Catalogue::InternalImage : public ImageNode
 
 		bool insertDriver( IECoreImage::DisplayDriverPtr driver, const IECore::CompoundData *parameters )
 		{
-			// If we represent a disk-based image, we can't accept
-			// a render.
-			if( fileNamePlug()->getValue() != "" )
+			// If we represent a disk-based, copied or compressed image,
+			// we can't accept a render.
+			if( !m_acceptingDrivers || fileNamePlug()->getValue() != "" || compressedImage() )
 			{
 				return false;
 			}
@@ -279,10 +557,82 @@ class Catalogue::InternalImage : public ImageNode
 			// All our drivers have been closed, so the render has completed.
 			// Save the image to disk. We do this in the background because
 			// saving large images with many AOVs takes several seconds.
+			// See AsynchronousSaver::Queue.
 
 			m_saver = AsynchronousSaver::create( this );
 		}
 
+		void prioritiseSave()
+		{
+			if( m_saver )
+			{
+				m_saver->prioritise();
+			}
+		}
+
+		static void waitForSaves()
+		{
+			AsynchronousSaver::waitForAll();
+		}
+
+		// Replaces our Display nodes with a compressed copy of their
+		// image, so that we use less memory while we're not being viewed.
+		// Images which are being saved to disk don't need this, because
+		// they'll be loaded from disk on demand once saved. Compression
+		// is performed in the background, and the Display nodes are
+		// only replaced when it has completed - see AsynchronousCompressor.
+		//
+		// Replacing the Display nodes can't be undone, so we only compress
+		// images whose Display nodes have never been edited by `copyFrom()`,
+		// which may be part of an undoable operation. Otherwise, undoing that
+		// operation would try to remove Displays which no longer exist.
+		void compress()
+		{
+			if( !m_compressible || m_saver || m_compressor || compressedImage() )
+			{
+				return;
+			}
+
+			const size_t numDisplays = copyChannels()->inPlugs()->children().size() - 1;
+			if( !numDisplays || m_numDriversClosed != numDisplays )
+			{
+				// No image, or the render is still in progress.
+				return;
+			}
+
+			m_compressor = AsynchronousCompressor::create( this );
+			m_acceptingDrivers = false;
+		}
+
+		// Returns the memory used to store the image, excluding any
+		// entries it has in the compute cache.
+		size_t memoryUsage() const
+		{
+			if( const CompressedImage *c = compressedImage() )
+			{
+				return c->getData()->memoryUsage;
+			}
+
+			// Display drivers store every tile as uncompressed floats.
+			size_t result = 0;
+			for( DisplayIterator it( this ); !it.done(); ++it )
+			{
+				const ImagePlug *image = (*it)->outPlug();
+				const Imath::Box2i dataWindow = image->dataWindowPlug()->getValue();
+				if( BufferAlgo::empty( dataWindow ) )
+				{
+					continue;
+				}
+				const Imath::V2i numTiles = (
+					ImagePlug::tileOrigin( dataWindow.max - Imath::V2i( 1 ) ) - ImagePlug::tileOrigin( dataWindow.min )
+				) / ImagePlug::tileSize() + Imath::V2i( 1 );
+				result += numTiles.x * numTiles.y * image->channelNamesPlug()->getValue()->readable().size() *
+					ImagePlug::tileSize() * ImagePlug::tileSize() * sizeof( float );
+			}
+
+			return result;
+		}
+
 	protected :
 
 		void hashChannelData( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const override
@@ -324,6 +674,31 @@ class Catalogue::InternalImage : public ImageNode
 			}
 		}
 
+		const CompressedImage *compressedImage() const
+		{
+			return getChild<CompressedImage>( g_compressedImageName );
+		}
+
+		void setCompressedData( CompressedImage::ConstDataPtr data )
+		{
+			if( CompressedImage *existing = getChild<CompressedImage>( g_compressedImageName ) )
+			{
+				removeChild( existing );
+			}
+
+			if( data )
+			{
+				CompressedImagePtr compressedImage = new CompressedImage( g_compressedImageName );
+				compressedImage->setData( data );
+				addChild( compressedImage );
+				text()->inPlug()->setInput( compressedImage->outPlug() );
+			}
+			else
+			{
+				text()->inPlug()->setInput( copyChannels()->outPlug() );
+			}
+		}
+
 		void removeDisplays()
 		{
 			vector<Display *> toDelete;
@@ -422,29 +797,37 @@ class Catalogue::InternalImage : public ImageNode
 				Ptr saver = Ptr( new AsynchronousSaver( imageCopy, fileName ) );
 				saver->registerClient( client );
 
-				// Note that the background thread doesn't own a reference to the saver -
+				// Note that the queue doesn't own a reference to the saver -
 				// see ~AsychronousSaver for details.
-				std::thread thread( boost::bind( &AsynchronousSaver::save, saver.get(), WeakPtr( saver ) ) );
-				saver->m_thread.swap( thread );
+				queue().push( saver );
 				return saver;
 			}
 
 			virtual ~AsynchronousSaver()
 			{
-				// Wait for our background thread to complete. This achieves
-				// two things :
+				// Remove ourselves from the queue, completing the save first
+				// so that the image isn't lost. This makes sure our member data
+				// is not deleted until the background thread has finished using
+				// it.
 				//
-				// - Makes sure our member data is not deleted until the background
-				//   thread has finished using it.
-				// - Ensures that the background thread finishes before program shutdown
-				//   reaches the stage of calling static destructors, at which point
-				//   it would crash as the libraries it relies on are torn down around it.
-				//
-				// Note that for this to work, the background thread must _not_ own a
+				// Note that for this to work, the queue must _not_ own a
 				// reference to `this`, as that would prevent destruction on the main
 				// thread and never give us an opportunity to wait for the background
 				// thread.
-				m_thread.join();
+				queue().remove( this );
+			}
+
+			// Blocks until all queued saves have completed.
+			static void waitForAll()
+			{
+				queue().wait();
+			}
+
+			// Moves us to the front of the queue, so that the image
+			// the user is looking at is saved before any others.
+			void prioritise()
+			{
+				queue().prioritise( this );
 			}
 
 			void registerClient( InternalImage *client )
@@ -485,7 +868,144 @@ class Catalogue::InternalImage : public ImageNode
 					m_writer->fileNamePlug()->setValue( fileName );
 				}
 
-				void save( WeakPtr forWrapUp )
+				// Saving large images with many AOVs can take several seconds, so
+				// we do it on a background thread. But rather than launch a thread
+				// per image, which oversubscribes the machine when many images
+				// complete at once, we save one image at a time on a single thread.
+				// Each save is itself parallelised by TBB, so all cores are still
+				// used.
+				class Queue
+				{
+
+					public :
+
+						Queue()
+							:	m_running( nullptr )
+						{
+						}
+
+						void push( const Ptr &saver )
+						{
+							{
+								std::unique_lock<std::mutex> lock( m_mutex );
+								m_pending.push_back( Entry( saver.get(), saver ) );
+								if( !m_thread.joinable() )
+								{
+									m_thread = std::thread( boost::bind( &Queue::run, this ) );
+								}
+							}
+							m_condition.notify_all();
+						}
+
+						void prioritise( AsynchronousSaver *saver )
+						{
+							std::unique_lock<std::mutex> lock( m_mutex );
+							Entries::iterator it = find( saver );
+							if( it != m_pending.end() )
+							{
+								const Entry entry = *it;
+								m_pending.erase( it );
+								m_pending.push_front( entry );
+							}
+						}
+
+						// Removes the saver from the queue, saving it immediately
+						// on the calling thread if it hasn't been started yet, or
+						// waiting for the background thread to finish it otherwise.
+						void remove( AsynchronousSaver *saver )
+						{
+							std::unique_lock<std::mutex> lock( m_mutex );
+							Entries::iterator it = find( saver );
+							if( it != m_pending.end() )
+							{
+								// Leave the entry in place, so that run() still
+								// schedules the (now no-op) wrap up on the UI thread.
+								it->first = nullptr;
+								lock.unlock();
+								saver->save();
+								return;
+							}
+							m_condition.wait( lock, [this, saver] { return m_running != saver; } );
+						}
+
+						void wait()
+						{
+							std::unique_lock<std::mutex> lock( m_mutex );
+							m_condition.wait( lock, [this] { return m_pending.empty() && !m_running; } );
+						}
+
+					private :
+
+						// The raw pointer is used for saving, and the weak pointer
+						// for wrapping up on the UI thread.
+						typedef std::pair<AsynchronousSaver *, WeakPtr> Entry;
+						typedef std::deque<Entry> Entries;
+
+						Entries::iterator find( AsynchronousSaver *saver )
+						{
+							return std::find_if(
+								m_pending.begin(), m_pending.end(),
+								[saver] ( const Entry &entry ) { return entry.first == saver; }
+							);
+						}
+
+						void run()
+						{
+							std::unique_lock<std::mutex> lock( m_mutex );
+							while( true )
+							{
+								m_condition.wait( lock, [this] { return !m_pending.empty(); } );
+
+								const Entry entry = m_pending.front();
+								m_pending.pop_front();
+								m_running = entry.first;
+
+								lock.unlock();
+								if( entry.first )
+								{
+									entry.first->save();
+								}
+
+								// Schedule execution of wrapUp() on the UI thread,
+								// to make our results visible to the user. Note that
+								// we absolutely _must not_ create a Ptr here on the
+								// background thread - ownership must be managed on
+								// the UI thread only (see ~AsynchronousSaver).
+								WeakPtr forWrapUp = entry.second;
+								ParallelAlgo::callOnUIThread(
+									[forWrapUp] {
+										if( Ptr that = forWrapUp.lock() )
+										{
+											that->wrapUp();
+										}
+									}
+								);
+								lock.lock();
+
+								m_running = nullptr;
+								m_condition.notify_all();
+							}
+						}
+
+						std::mutex m_mutex;
+						std::condition_variable m_condition;
+						Entries m_pending;
+						AsynchronousSaver *m_running;
+						std::thread m_thread;
+
+				};
+
+				static Queue &queue()
+				{
+					// Deliberately leaked. Destroying the queue during static
+					// destruction would be too late to complete any pending saves,
+					// because the libraries they rely on are being torn down. Instead,
+					// `Catalogue::waitForSaves()` is called explicitly at exit.
+					static Queue *q = new Queue;
+					return *q;
+				}
+
+				void save()
 				{
 					ImageAlgo::parallelGatherTiles(
 						m_imageCopy->copyChannels()->outPlug(),
@@ -510,20 +1030,6 @@ class Catalogue::InternalImage : public ImageNode
 					{
 						IECore::msg( IECore::Msg::Error, "Saving Catalogue image", e.what() );
 					}
-
-					// Schedule execution of wrapUp() on the UI thread,
-					// to make our results visible to the user. Note that
-					// we absolutely _must not_ create a Ptr here on the
-					// background thread - ownership must be managed on
-					// the UI thread only (see ~AsynchronousSaver).
-					ParallelAlgo::callOnUIThread(
-						[forWrapUp] {
-							if( Ptr that = forWrapUp.lock() )
-							{
-								that->wrapUp();
-							}
-						}
-					);
 				}
 
 				void wrapUp()
@@ -558,14 +1064,104 @@ class Catalogue::InternalImage : public ImageNode
 				InternalImagePtr m_imageCopy;
 				ImageWriterPtr m_writer;
 
-				std::thread m_thread;
 				set<InternalImage *> m_clients;
 
 		};
 
+		// Compressing large images with many AOVs can take a while, so we
+		// do it on a background thread rather than block the UI.
+		struct AsynchronousCompressor
+		{
+
+			typedef std::shared_ptr<AsynchronousCompressor> Ptr;
+			typedef std::weak_ptr<AsynchronousCompressor> WeakPtr;
+
+			static Ptr create( InternalImage *client )
+			{
+				// As for AsynchronousSaver, we compress a copy of the image,
+				// because the original might be modified on the main thread
+				// while we work in the background.
+
+				InternalImagePtr imageCopy = new InternalImage;
+
+				size_t i = 0;
+				for( DisplayIterator it( client ); !it.done(); ++it )
+				{
+					Display *display = it->get();
+					DisplayPtr displayCopy = new Display;
+					displayCopy->setDriver( display->getDriver(), /* copy = */ true );
+					imageCopy->addChild( displayCopy );
+					imageCopy->copyChannels()->inPlugs()->getChild<Plug>( i++ )->setInput( displayCopy->outPlug() );
+				}
+
+				Ptr compressor = Ptr( new AsynchronousCompressor( client, imageCopy ) );
+
+				// Note that the background function doesn't own a reference to the
+				// compressor, so that ownership is managed on the UI thread only.
+				// Destroying the compressor cancels the background function and
+				// waits for it to finish.
+				AsynchronousCompressor *rawCompressor = compressor.get();
+				WeakPtr forWrapUp = compressor;
+				compressor->m_task = ParallelAlgo::callOnBackgroundThread(
+					imageCopy->copyChannels()->outPlug(),
+					[rawCompressor, forWrapUp] {
+						rawCompressor->m_data = CompressedImage::compress( rawCompressor->m_imageCopy->copyChannels()->outPlug() );
+						ParallelAlgo::callOnUIThread(
+							[forWrapUp] {
+								if( Ptr that = forWrapUp.lock() )
+								{
+									that->wrapUp();
+								}
+							}
+						);
+					}
+				);
+
+				return compressor;
+			}
+
+			private :
+
+				AsynchronousCompressor( InternalImage *client, InternalImagePtr imageCopy )
+					:	m_client( client ), m_imageCopy( imageCopy )
+				{
+				}
+
+				void wrapUp()
+				{
+					// Compression is just an implementation detail, so it mustn't
+					// appear in the undo queue. That would also keep the uncompressed
+					// images alive. Note that we are called as a separate UI thread
+					// event, so we can't be interleaved with any undoable edits, and
+					// that `compress()` guarantees that none of the children we edit
+					// are referenced by the undo queue.
+					UndoScope undoDisabler( m_client->ancestor<ScriptNode>(), UndoScope::Disabled );
+					DirtyPropagationScope dirtyPropagationScope;
+
+					m_client->setCompressedData( m_data );
+					m_client->removeDisplays();
+					// Destroys us, but our caller holds a reference
+					// until we return.
+					m_client->m_compressor = nullptr;
+				}
+
+				InternalImage *m_client;
+				InternalImagePtr m_imageCopy;
+				CompressedImage::ConstDataPtr m_data;
+				// Declared last, so that it is destroyed first, waiting for
+				// the background function to stop using our other members.
+				std::unique_ptr<BackgroundTask> m_task;
+
+		};
+
 		int m_clientPID;
+		// False once our image is complete, so that
+		// insertDriver() will reject new drivers.
+		bool m_acceptingDrivers;
+		bool m_compressible;
 		size_t m_numDriversClosed;
 		AsynchronousSaver::Ptr m_saver;
+		AsynchronousCompressor::Ptr m_compressor;
 
 		static size_t g_firstChildIndex;
 
@@ -636,6 +1232,11 @@ void Catalogue::Image::save( const std::string &fileName ) const
 	Catalogue::imageNode( this )->save( fileName );
 }
 
+size_t Catalogue::Image::memoryUsage() const
+{
+	return Catalogue::imageNode( this )->memoryUsage();
+}
+
 Gaffer::PlugPtr Catalogue::Image::createCounterpart( const std::string &name, Direction direction ) const
 {
 	return new Image( name, direction, getFlags() );
@@ -705,6 +1306,8 @@ Catalogue::Catalogue( const std::string &name )
 
 	Display::driverCreatedSignal().connect( boost::bind( &Catalogue::driverCreated, this, ::_1, ::_2 ) );
 	Display::imageReceivedSignal().connect( boost::bind( &Catalogue::imageReceived, this, ::_1 ) );
+
+	plugSetSignal().connect( boost::bind( &Catalogue::plugSet, this, ::_1 ) );
 }
 
 Catalogue::~Catalogue()
@@ -935,6 +1538,11 @@ IECoreImage::DisplayDriverServer *Catalogue::displayDriverServer()
 	return g_server.get();
 }
 
+void Catalogue::waitForSaves()
+{
+	InternalImage::waitForSaves();
+}
+
 void Catalogue::driverCreated( IECoreImage::DisplayDriver *driver, const IECore::CompoundData *parameters )
 {
 	// Check the image is destined for catalogues in general
@@ -995,6 +1603,55 @@ void Catalogue::imageReceived( Gaffer::Plug *plug )
 
 	InternalImage *internalImage = static_cast<InternalImage *>( plug->node()->parent<Node>() );
 	internalImage->driverClosed();
+
+	prioritiseActiveImage();
+	compressInactiveImages();
+}
+
+void Catalogue::plugSet( Gaffer::Plug *plug )
+{
+	if( plug == imageIndexPlug() )
+	{
+		prioritiseActiveImage();
+		compressInactiveImages();
+	}
+}
+
+void Catalogue::prioritiseActiveImage()
+{
+	Plug *images = imagesPlug()->source();
+	const int imageIndex = imageIndexPlug()->getValue();
+	if( imageIndex < 0 || imageIndex >= (int)images->children().size() )
+	{
+		return;
+	}
+
+	if( InternalImage *internalImage = imageNode( images->getChild<Image>( imageIndex ) ) )
+	{
+		internalImage->prioritiseSave();
+	}
+}
+
+void Catalogue::compressInactiveImages()
+{
+	if( undoingOrRedoing( this ) )
+	{
+		return;
+	}
+
+	Plug *images = imagesPlug()->source();
+	const int imageIndex = imageIndexPlug()->getValue();
+	for( int i = 0, e = images->children().size(); i < e; ++i )
+	{
+		if( i == imageIndex )
+		{
+			continue;
+		}
+		if( InternalImage *internalImage = imageNode( images->getChild<Image>( i ) ) )
+		{
+			internalImage->compress();
+		}
+	}
 }
 
 void Catalogue::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
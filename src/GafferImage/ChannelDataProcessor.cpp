@@ -74,6 +74,14 @@ const Gaffer::StringPlug *ChannelDataProcessor::channelsPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex );
 }
 
+bool ChannelDataProcessor::supportsMipLevels() const
+{
+	// Exact for a Grade with unit gamma and no clamping. Approximate for
+	// Clamp, for gamma, and for Premultiply and Unpremultiply, which use
+	// the filtered alpha rather than filtering the product.
+	return true;
+}
+
 void ChannelDataProcessor::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -378,14 +378,17 @@ void CollectImages::hashChannelData( const GafferImage::ImagePlug *parent, const
 	{
 		h = inputChannelDataHash;
 	}
+	else if( BufferAlgo::empty( validBound ) )
+	{
+		// Matches the `blackTile()` returned by `computeChannelData()`,
+		// so that we share its cache entry.
+		h = ImagePlug::blackTile()->Object::hash();
+	}
 	else
 	{
 		ImageProcessor::hashChannelData( parent, context, h );
-		if( !BufferAlgo::empty( validBound ) )
-		{
-			h.append( inputChannelDataHash );
-			h.append( BufferAlgo::intersection( inputDataWindow, tileBound ) );
-		}
+		h.append( inputChannelDataHash );
+		h.append( validBound );
 	}
 }
 
@@ -52,6 +52,16 @@ namespace
 
 const IECore::InternedString g_layerNameKey( "image:colorProcessor:__layerName" );
 
+vector<string> rgbChannelNames( const Gaffer::Context *context )
+{
+	const string &layerName = context->get<string>( g_layerNameKey );
+	return {
+		ImageAlgo::channelName( layerName, "R" ),
+		ImageAlgo::channelName( layerName, "G" ),
+		ImageAlgo::channelName( layerName, "B" )
+	};
+}
+
 } // namespace
 
 IE_CORE_DEFINERUNTIMETYPED( ColorProcessor );
@@ -109,6 +119,13 @@ const Gaffer::ObjectPlug *ColorProcessor::colorDataPlug() const
 	return getChild<ObjectPlug>( g_firstPlugIndex + 1 );
 }
 
+bool ColorProcessor::supportsMipLevels() const
+{
+	// Colour transforms are rarely linear, so the reduced image is only an
+	// approximation. See ImageNode::supportsMipLevels().
+	return true;
+}
+
 void ColorProcessor::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -140,33 +157,15 @@ void ColorProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context *
 {
 	if( output == colorDataPlug() )
 	{
-		ConstStringVectorDataPtr channelNamesData;
-		{
-			ImagePlug::GlobalScope globalScope( context );
-			channelNamesData = inPlug()->channelNamesPlug()->getValue();
-		}
-		const vector<string> &channelNames = channelNamesData->readable();
-
-		const string &layerName = context->get<string>( g_layerNameKey );
+		const vector<ConstFloatVectorDataPtr> inputRGB = inPlug()->channelData(
+			rgbChannelNames( context ),
+			context->get<Imath::V2i>( ImagePlug::tileOriginContextName )
+		);
 
 		FloatVectorDataPtr rgb[3];
+		for( int i = 0; i < 3; ++i )
 		{
-			ImagePlug::ChannelDataScope channelDataScope( context );
-			int i = 0;
-			for( const auto &baseName : { "R", "G", "B" } )
-			{
-				string channelName = ImageAlgo::channelName( layerName, baseName );
-				if( ImageAlgo::channelExists( channelNames, channelName ) )
-				{
-					channelDataScope.setChannelName( channelName );
-					rgb[i] = inPlug()->channelDataPlug()->getValue()->copy();
-				}
-				else
-				{
-					rgb[i] = ImagePlug::blackTile()->copy();
-				}
-				i++;
-			}
+			rgb[i] = inputRGB[i]->copy();
 		}
 
 		processColorData( context, rgb[0].get(), rgb[1].get(), rgb[2].get() );
@@ -239,27 +238,9 @@ bool ColorProcessor::affectsColorData( const Gaffer::Plug *input ) const
 
 void ColorProcessor::hashColorData( const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	ConstStringVectorDataPtr channelNamesData;
-	{
-		ImagePlug::GlobalScope globalScope( context );
-		channelNamesData = inPlug()->channelNamesPlug()->getValue();
-	}
-	const vector<string> &channelNames = channelNamesData->readable();
-
-	const string &layerName = context->get<string>( g_layerNameKey );
-
-	ImagePlug::ChannelDataScope channelDataScope( context );
-	for( const auto &baseName : { "R", "G", "B" } )
-	{
-		string channelName = ImageAlgo::channelName( layerName, baseName );
-		if( ImageAlgo::channelExists( channelNames, channelName ) )
-		{
-			channelDataScope.setChannelName( channelName );
-			inPlug()->channelDataPlug()->hash( h );
-		}
-		else
-		{
-			ImagePlug::blackTile()->hash( h );
-		}
-	}
+	inPlug()->channelDataHash(
+		rgbChannelNames( context ),
+		context->get<Imath::V2i>( ImagePlug::tileOriginContextName ),
+		h
+	);
 }
@@ -120,6 +120,11 @@ const Gaffer::CompoundObjectPlug *CopyChannels::mappingPlug() const
 	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 1 );
 }
 
+bool CopyChannels::supportsMipLevels() const
+{
+	return true;
+}
+
 void CopyChannels::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -277,14 +282,17 @@ void CopyChannels::hashChannelData( const GafferImage::ImagePlug *parent, const
 		{
 			h = inputImage->channelDataPlug()->hash();
 		}
+		else if( BufferAlgo::empty( validBound ) )
+		{
+			// Tiles entirely outside the input data window share
+			// the cache entry for the black tile.
+			h = ImagePlug::blackTile()->Object::hash();
+		}
 		else
 		{
 			ImageProcessor::hashChannelData( parent, context, h );
-			if( !BufferAlgo::empty( validBound ) )
-			{
-				inputImage->channelDataPlug()->hash( h );
-				h.append( BufferAlgo::intersection( inputDataWindow, tileBound ) );
-			}
+			inputImage->channelDataPlug()->hash( h );
+			h.append( validBound );
 		}
 	}
 	else
@@ -315,23 +323,24 @@ IECore::ConstFloatVectorDataPtr CopyChannels::computeChannelData( const std::str
 		{
 			return inputImage->channelDataPlug()->getValue();
 		}
+		else if( BufferAlgo::empty( validBound ) )
+		{
+			return ImagePlug::blackTile();
+		}
 		else
 		{
 			FloatVectorDataPtr resultData = new FloatVectorData;
 			vector<float> &result = resultData->writable();
 			result.resize( ImagePlug::tileSize() * ImagePlug::tileSize(), 0.0f );
-			if( !BufferAlgo::empty( validBound ) )
-			{
-				ConstFloatVectorDataPtr inputData = inputImage->channelDataPlug()->getValue();
-				copyRegion(
-					&inputData->readable().front(),
-					tileBound,
-					validBound,
-					&result.front(),
-					tileBound,
-					validBound.min
-				);
-			}
+			ConstFloatVectorDataPtr inputData = inputImage->channelDataPlug()->getValue();
+			copyRegion(
+				&inputData->readable().front(),
+				tileBound,
+				validBound,
+				&result.front(),
+				tileBound,
+				validBound.min
+			);
 			return resultData;
 		}
 	}
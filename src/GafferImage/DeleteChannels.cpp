@@ -91,6 +91,11 @@ const Gaffer::StringPlug *DeleteChannels::channelsPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 1 );
 }
 
+bool DeleteChannels::supportsMipLevels() const
+{
+	return true;
+}
+
 void DeleteChannels::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -55,7 +55,12 @@
 
 #include "tbb/spin_mutex.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 using namespace Imath;
@@ -80,6 +85,7 @@ class GafferDisplayDriver : public IECoreImage::DisplayDriver
 		GafferDisplayDriver( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow,
 			const vector<string> &channelNames, ConstCompoundDataPtr parameters )
 			:	DisplayDriver( displayWindow, dataWindow, channelNames, parameters ),
+				m_hasPendingTiles( false ),
 				m_gafferFormat( displayWindow, 1, /* fromEXRSpace = */ true ),
 				m_gafferDataWindow( m_gafferFormat.fromEXRSpace( dataWindow ) )
 		{
@@ -110,6 +116,7 @@ class GafferDisplayDriver : public IECoreImage::DisplayDriver
 
 		GafferDisplayDriver( GafferDisplayDriver &other )
 			:	DisplayDriver( other.displayWindow(), other.dataWindow(), other.channelNames(), other.parameters() ),
+				m_hasPendingTiles( false ),
 				m_gafferFormat( other.m_gafferFormat ), m_gafferDataWindow( other.m_gafferDataWindow ),
 				m_parameters( other.m_parameters )
 		{
@@ -149,30 +156,35 @@ class GafferDisplayDriver : public IECoreImage::DisplayDriver
 		{
 			Box2i gafferBox = m_gafferFormat.fromEXRSpace( box );
 
+			// Buckets may span several tiles, so we hold a bucket lock to
+			// prevent `publish()` from making just part of a bucket visible.
+			// Many buckets may be written concurrently.
+			tbb::spin_rw_mutex::scoped_lock bucketLock( m_bucketMutex, /* write = */ false );
+
 			const V2i boxMinTileOrigin = ImagePlug::tileOrigin( gafferBox.min );
 			const V2i boxMaxTileOrigin = ImagePlug::tileOrigin( gafferBox.max - Imath::V2i( 1 ) );
 			for( int tileOriginY = boxMinTileOrigin.y; tileOriginY <= boxMaxTileOrigin.y; tileOriginY += ImagePlug::tileSize() )
 			{
 				for( int tileOriginX = boxMinTileOrigin.x; tileOriginX <= boxMaxTileOrigin.x; tileOriginX += ImagePlug::tileSize() )
 				{
+					const V2i tileOrigin( tileOriginX, tileOriginY );
+					const Box2i tileBound( tileOrigin, tileOrigin + Imath::V2i( GafferImage::ImagePlug::tileSize() ) );
+					const Box2i transferBound = IECore::boxIntersection( tileBound, gafferBox );
+
 					for( int channelIndex = 0, numChannels = channelNames().size(); channelIndex < numChannels; ++channelIndex )
 					{
-						const V2i tileOrigin( tileOriginX, tileOriginY );
-						ConstFloatVectorDataPtr tileData = getTile( tileOrigin, channelIndex );
-						if( !tileData )
+						Tile *tile = this->tile( tileOrigin, channelIndex );
+						if( !tile )
 						{
 							// we've been sent data outside of the data window
 							continue;
 						}
 
-						// we must create a new object to hold the updated tile data,
-						// because the old one might well have been returned from
-						// computeChannelData and be being held in the cache.
-						FloatVectorDataPtr updatedTileData = tileData->copy();
-						vector<float> &updatedTile = updatedTileData->writable();
-
-						const Box2i tileBound( tileOrigin, tileOrigin + Imath::V2i( GafferImage::ImagePlug::tileSize() ) );
-						const Box2i transferBound = IECore::boxIntersection( tileBound, gafferBox );
+						// We write directly into the pending data for the tile,
+						// which isn't visible to computations until `publish()`
+						// is called.
+						Tile::Mutex::scoped_lock lock( tile->mutex );
+						vector<float> &updatedTile = pendingData( *tile, /* overwriteAll = */ transferBound == tileBound );
 
 						for( int y = transferBound.min.y; y<transferBound.max.y; ++y )
 						{
@@ -187,17 +199,19 @@ class GafferDisplayDriver : public IECoreImage::DisplayDriver
 								dstIndex++;
 							}
 						}
-
-						setTile( tileOrigin, channelIndex, updatedTileData );
 					}
 				}
 			}
 
+			bucketLock.release();
 			dataReceivedSignal()( this, box );
 		}
 
 		void imageClose() override
 		{
+			// Make sure the complete image is visible to
+			// anyone responding to the signal.
+			publish();
 			imageReceivedSignal()( this );
 		}
 
@@ -213,20 +227,65 @@ class GafferDisplayDriver : public IECoreImage::DisplayDriver
 
 		ConstFloatVectorDataPtr channelData( const Imath::V2i &tileOrigin, const std::string &channelName )
 		{
-			vector<string>::const_iterator cIt = find( channelNames().begin(), channelNames().end(), channelName );
-			if( cIt == channelNames().end() )
+			ConstFloatVectorDataPtr result;
+			MurmurHash hash;
+			publishedTile( tileOrigin, channelName, result, hash );
+			return result;
+		}
+
+		MurmurHash channelDataHash( const Imath::V2i &tileOrigin, const std::string &channelName )
+		{
+			// Publishing is usually done by the Display node just before it
+			// signals an update. But there may be no UI event loop to run the
+			// update, as is the case in tests and batch processes. So we also
+			// publish here, so data is visible as soon as anyone asks for it.
+			// Computes always hash before computing, so `channelData()` will
+			// see the same data.
+			if( m_hasPendingTiles )
 			{
-				return ImagePlug::blackTile();
+				publish();
 			}
 
-			ConstFloatVectorDataPtr tile = getTile( tileOrigin, cIt - channelNames().begin() );
-			if( tile )
+			ConstFloatVectorDataPtr data;
+			MurmurHash result;
+			publishedTile( tileOrigin, channelName, data, result );
+			return result;
+		}
+
+		// Makes all the complete buckets received so far visible via
+		// `channelData()`. We defer this until the Display node is ready to
+		// signal the update, so that many buckets can be received for the
+		// price of a single copy of each tile they touch.
+		void publish()
+		{
+			// Wait for any buckets being written to complete, and
+			// stop new ones from starting until we're done.
+			tbb::spin_rw_mutex::scoped_lock bucketLock( m_bucketMutex, /* write = */ true );
+
+			vector<Tile *> pendingTiles;
 			{
-				return tile;
+				tbb::spin_mutex::scoped_lock pendingLock( m_pendingTilesMutex );
+				pendingTiles.swap( m_pendingTiles );
+				m_hasPendingTiles = false;
 			}
-			else
+
+			if( pendingTiles.empty() )
 			{
-				return ImagePlug::blackTile();
+				return;
+			}
+
+			tbb::spin_rw_mutex::scoped_lock tileLock( m_tileMutex, true /* write */ );
+			for( Tile *tile : pendingTiles )
+			{
+				Tile::Mutex::scoped_lock lock( tile->mutex );
+				tile->spareData = tile->data;
+				tile->data = tile->pendingData;
+				tile->pendingData = nullptr;
+				// Hashing the tile data itself would be expensive, so instead
+				// we give each published tile a unique hash.
+				tile->hash = MurmurHash();
+				tile->hash.append( "GafferDisplayDriver" );
+				tile->hash.append( (uint64_t)g_publishCount++ );
 			}
 		}
 
@@ -251,7 +310,44 @@ class GafferDisplayDriver : public IECoreImage::DisplayDriver
 			Display::driverCreatedSignal()( driver.get(), parameters.get() );
 		}
 
-		ConstFloatVectorDataPtr getTile( const V2i &tileOrigin, size_t channelIndex )
+		// Storage for a single channel of a tile. Data for the tile is double
+		// buffered : `imageData()` writes into `pendingData` while `data` remains
+		// visible to computations, and `publish()` swaps them over.
+		struct Tile
+		{
+
+			Tile() = default;
+
+			Tile( const Tile &other )
+				:	data( other.data ), hash( other.hash )
+			{
+			}
+
+			Tile &operator = ( const Tile &other )
+			{
+				data = other.data;
+				hash = other.hash;
+				return *this;
+			}
+
+			// Only written by `publish()`, which holds both `m_tileMutex` and
+			// `m_bucketMutex` for writing. So either may be held for reading
+			// to read them. Null for black tiles.
+			FloatVectorDataPtr data;
+			MurmurHash hash;
+
+			// Protected by `mutex`.
+			FloatVectorDataPtr pendingData;
+			// The previously published data, which we may reuse as `pendingData`
+			// once there are no other references to it.
+			FloatVectorDataPtr spareData;
+
+			typedef tbb::spin_mutex Mutex;
+			Mutex mutex;
+
+		};
+
+		Tile *tile( const V2i &tileOrigin, size_t channelIndex )
 		{
 			V2i tileIndex = tileOrigin / ImagePlug::tileSize();
 
@@ -266,29 +362,83 @@ class GafferDisplayDriver : public IECoreImage::DisplayDriver
 				return nullptr;
 			}
 
-			tbb::spin_rw_mutex::scoped_lock tileLock( m_tileMutex, false /* read */ );
+			return &m_tiles[tileIndex.x][tileIndex.y][channelIndex];
+		}
+
+		void publishedTile( const V2i &tileOrigin, const std::string &channelName, ConstFloatVectorDataPtr &data, MurmurHash &hash )
+		{
+			static const MurmurHash g_blackTileHash = ImagePlug::blackTile()->Object::hash();
+			data = ImagePlug::blackTile();
+			hash = g_blackTileHash;
 
-			ConstFloatVectorDataPtr result = m_tiles[tileIndex.x][tileIndex.y][channelIndex];
-			if( !result )
+			vector<string>::const_iterator cIt = find( channelNames().begin(), channelNames().end(), channelName );
+			if( cIt == channelNames().end() )
 			{
-				result = ImagePlug::blackTile();
+				return;
 			}
 
-			return result;
+			const Tile *tile = this->tile( tileOrigin, cIt - channelNames().begin() );
+			if( !tile )
+			{
+				return;
+			}
+
+			tbb::spin_rw_mutex::scoped_lock tileLock( m_tileMutex, false /* read */ );
+			if( tile->data )
+			{
+				data = tile->data;
+				hash = tile->hash;
+			}
 		}
 
-		void setTile( const V2i &tileOrigin, size_t channelIndex, ConstFloatVectorDataPtr tile )
+		// Returns the buffer that `imageData()` should write into for `tile`,
+		// initialising it from the published data unless we're about to
+		// overwrite it all anyway. Must be called with `tile.mutex` held, and
+		// with `m_bucketMutex` held for reading.
+		vector<float> &pendingData( Tile &tile, bool overwriteAll )
 		{
-			V2i tileIndex = tileOrigin / ImagePlug::tileSize();
-			tbb::spin_rw_mutex::scoped_lock tileLock( m_tileMutex, true /* write */ );
-			m_tiles[tileIndex.x][tileIndex.y][channelIndex] = tile;
+			if( !tile.pendingData )
+			{
+				if( tile.spareData && tile.spareData->refCount() == 1 )
+				{
+					// No-one else can see the spare data, so we can
+					// reuse it rather than allocate.
+					tile.pendingData = tile.spareData;
+				}
+				else
+				{
+					tile.pendingData = new FloatVectorData;
+					tile.pendingData->writable().resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
+				}
+				tile.spareData = nullptr;
+
+				if( !overwriteAll )
+				{
+					const vector<float> &src = tile.data ? tile.data->readable() : ImagePlug::blackTile()->readable();
+					std::copy( src.begin(), src.end(), tile.pendingData->writable().begin() );
+				}
+
+				tbb::spin_mutex::scoped_lock pendingLock( m_pendingTilesMutex );
+				m_pendingTiles.push_back( &tile );
+				m_hasPendingTiles = true;
+			}
+
+			return tile.pendingData->writable();
 		}
 
 		// indexed by tileIndexX, tileIndexY, channelIndex.
-		typedef boost::multi_array<ConstFloatVectorDataPtr, 3> TileArray;
+		typedef boost::multi_array<Tile, 3> TileArray;
 		TileArray m_tiles;
 		tbb::spin_rw_mutex m_tileMutex;
 
+		vector<Tile *> m_pendingTiles;
+		tbb::spin_mutex m_pendingTilesMutex;
+		std::atomic_bool m_hasPendingTiles;
+		// Held for reading by `imageData()` and for writing by `publish()`.
+		tbb::spin_rw_mutex m_bucketMutex;
+
+		static std::atomic<uint64_t> g_publishCount;
+
 		Format m_gafferFormat;
 		Imath::Box2i m_gafferDataWindow;
 		IECore::ConstCompoundDataPtr m_parameters;
@@ -298,6 +448,7 @@ class GafferDisplayDriver : public IECoreImage::DisplayDriver
 };
 
 const IECoreImage::DisplayDriver::DisplayDriverDescription<GafferDisplayDriver> GafferDisplayDriver::g_description;
+std::atomic<uint64_t> GafferDisplayDriver::g_publishCount( 0 );
 
 } // namespace GafferImage
 
@@ -470,15 +621,17 @@ IECore::ConstCompoundDataPtr Display::computeMetadata( const Gaffer::Context *co
 
 void Display::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	ConstFloatVectorDataPtr channelData = ImagePlug::blackTile();
 	if( m_driver )
 	{
-		channelData = m_driver->channelData(
+		h = m_driver->channelDataHash(
 			context->get<Imath::V2i>( ImagePlug::tileOriginContextName ),
 			context->get<std::string>( ImagePlug::channelNameContextName )
 		);
 	}
-	h = channelData->Object::hash();
+	else
+	{
+		h = ImagePlug::blackTile()->Object::hash();
+	}
 }
 
 IECore::ConstFloatVectorDataPtr Display::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
@@ -525,6 +678,7 @@ struct PendingUpdates
 
 	tbb::spin_mutex mutex;
 	PlugSetPtr plugs;
+	std::chrono::steady_clock::time_point lastUpdateTime;
 
 };
 
@@ -534,14 +688,85 @@ PendingUpdates &pendingUpdates()
 	return *p;
 }
 
+std::atomic<float> g_updateInterval( 0.05f );
+
+// Calls a function on the UI thread once a deadline has passed. This
+// lets us delay updates without blocking the renderer, using a single
+// thread no matter how many updates are scheduled.
+class UpdateTimer
+{
+
+	public :
+
+		UpdateTimer( const ParallelAlgo::UIThreadFunction &function )
+			:	m_function( function ), m_scheduled( false )
+		{
+			std::thread( [this] { run(); } ).detach();
+		}
+
+		void schedule( std::chrono::steady_clock::time_point deadline )
+		{
+			std::unique_lock<std::mutex> lock( m_mutex );
+			m_deadline = deadline;
+			m_scheduled = true;
+			m_condition.notify_one();
+		}
+
+	private :
+
+		void run()
+		{
+			std::unique_lock<std::mutex> lock( m_mutex );
+			while( true )
+			{
+				if( !m_scheduled )
+				{
+					m_condition.wait( lock );
+				}
+				else if( m_condition.wait_until( lock, m_deadline ) == std::cv_status::timeout )
+				{
+					m_scheduled = false;
+					lock.unlock();
+					try
+					{
+						ParallelAlgo::callOnUIThread( m_function );
+					}
+					catch( const std::exception &e )
+					{
+						IECore::msg( IECore::Msg::Error, "Display::UpdateTimer", e.what() );
+					}
+					lock.lock();
+				}
+			}
+		}
+
+		const ParallelAlgo::UIThreadFunction m_function;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::chrono::steady_clock::time_point m_deadline;
+		bool m_scheduled;
+
+};
+
 };
 
+void Display::setUpdateInterval( float seconds )
+{
+	g_updateInterval = std::max( 0.0f, seconds );
+}
+
+float Display::getUpdateInterval()
+{
+	return g_updateInterval;
+}
+
 // Called on a background thread when data is received on the driver.
 // We need to increment `updateCountPlug()`, but all graph edits must
 // be performed on the UI thread, so we can't do it directly.
 void Display::dataReceived()
 {
 	bool scheduleUpdate = false;
+	std::chrono::steady_clock::duration delay( 0 );
 	{
 		// To minimise overhead we perform updates in batches by storing
 		// a set of plugs which are pending update. If we're the creator
@@ -554,12 +779,29 @@ void Display::dataReceived()
 		{
 			scheduleUpdate = true;
 			pending.plugs.reset( new PlugSet );
+			// Updates are no more frequent than the update interval,
+			// so that data arriving in the meantime joins the batch.
+			const auto nextUpdateTime = pending.lastUpdateTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::duration<float>( g_updateInterval )
+			);
+			delay = nextUpdateTime - std::chrono::steady_clock::now();
 		}
 		pending.plugs->insert( outPlug() );
 	}
 	if( scheduleUpdate )
 	{
-		ParallelAlgo::callOnUIThread( &Display::dataReceivedUI );
+		if( delay > std::chrono::steady_clock::duration( 0 ) )
+		{
+			// We mustn't block the renderer while we wait, so we
+			// leave the timer to call us back. We deliberately leak
+			// it, because its thread never exits.
+			static UpdateTimer *g_timer = new UpdateTimer( &Display::dataReceivedUI );
+			g_timer->schedule( std::chrono::steady_clock::now() + delay );
+		}
+		else
+		{
+			ParallelAlgo::callOnUIThread( &Display::dataReceivedUI );
+		}
 	}
 }
 
@@ -578,6 +820,7 @@ void Display::dataReceivedUI()
 		PendingUpdates &pending = pendingUpdates();
 		tbb::spin_mutex::scoped_lock lock( pending.mutex );
 		batch.reset( pending.plugs.release() );
+		pending.lastUpdateTime = std::chrono::steady_clock::now();
 	}
 
 	// Now increment the update count for the Display nodes
@@ -595,6 +838,10 @@ void Display::dataReceivedUI()
 			// the time we're called, so we must check.
 			if( Display *display = runTimeCast<Display>( plug->node() ) )
 			{
+				if( display->m_driver )
+				{
+					display->m_driver->publish();
+				}
 				display->updateCountPlug()->setValue( display->updateCountPlug()->getValue() + 1 );
 			}
 		}
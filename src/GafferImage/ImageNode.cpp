@@ -37,6 +37,7 @@
 
 #include "GafferImage/ImageNode.h"
 
+#include "GafferImage/BufferAlgo.h"
 #include "GafferImage/FormatPlug.h"
 
 #include "Gaffer/Context.h"
@@ -48,6 +49,42 @@ using namespace IECore;
 using namespace GafferImage;
 using namespace Gaffer;
 
+//////////////////////////////////////////////////////////////////////////
+// Utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// A divide that always rounds down, instead of towards zero.
+int floorDivide( int a, int b )
+{
+	int result = a / b;
+	return result - ( a - result * b < 0 );
+}
+
+// Returns the box covering all the pixels at `mipLevel` which
+// overlap `box` at full resolution.
+Box2i mipLevelBox( const Box2i &box, int mipLevel )
+{
+	if( BufferAlgo::empty( box ) )
+	{
+		return box;
+	}
+
+	const int factor = 1 << mipLevel;
+	return Box2i(
+		V2i( floorDivide( box.min.x, factor ), floorDivide( box.min.y, factor ) ),
+		V2i( -floorDivide( -box.max.x, factor ), -floorDivide( -box.max.y, factor ) )
+	);
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ImageNode
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( ImageNode );
 
 size_t ImageNode::g_firstPlugIndex = 0;
@@ -89,6 +126,11 @@ bool ImageNode::enabled() const
 	return enabledPlug()->getValue();
 };
 
+bool ImageNode::supportsMipLevels() const
+{
+	return false;
+}
+
 void ImageNode::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	const ImagePlug *imagePlug = output->parent<ImagePlug>();
@@ -99,6 +141,13 @@ void ImageNode::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *co
 	}
 	if( imagePlug && enabledValue )
 	{
+		const int mipLevel = context->get<int>( ImagePlug::mipLevelContextName, 0 );
+		if( mipLevel > 0 && !supportsMipLevels() )
+		{
+			hashMipLevel( imagePlug, output, mipLevel, context, h );
+			return;
+		}
+
 		// We don't call ComputeNode::hash() immediately here, because for subclasses which
 		// want to pass through a specific hash in the hash*() methods it's a waste of time (the
 		// hash will get overwritten anyway). Instead we call ComputeNode::hash() in our
@@ -201,6 +250,13 @@ void ImageNode::compute( ValuePlug *output, const Context *context ) const
 		return;
 	}
 
+	const int mipLevel = context->get<int>( ImagePlug::mipLevelContextName, 0 );
+	if( mipLevel > 0 && !supportsMipLevels() )
+	{
+		computeMipLevel( imagePlug, output, mipLevel, context );
+		return;
+	}
+
 	// node is enabled - defer to our derived classes to perform the appropriate computation
 
 	if( output == imagePlug->formatPlug() )
@@ -273,6 +329,142 @@ IECore::ConstFloatVectorDataPtr ImageNode::computeChannelData( const std::string
 	throw IECore::NotImplementedException( string( typeName() ) + "::computeChannelData" );
 }
 
+void ImageNode::hashMipLevel( const ImagePlug *parent, const Gaffer::ValuePlug *output, int mipLevel, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	// We derive everything from our own output at full resolution.
+	Context::EditableScope fullResolutionScope( context );
+	fullResolutionScope.remove( ImagePlug::mipLevelContextName );
+
+	if( output == parent->metadataPlug() || output == parent->channelNamesPlug() )
+	{
+		// These are the same at all resolutions, so we can pass them through.
+		h = output->hash();
+		return;
+	}
+
+	ComputeNode::hash( output, context, h );
+	h.append( mipLevel );
+
+	if( output == parent->formatPlug() )
+	{
+		parent->formatPlug()->hash( h );
+	}
+	else if( output == parent->dataWindowPlug() )
+	{
+		parent->dataWindowPlug()->hash( h );
+	}
+	else if( output == parent->channelDataPlug() )
+	{
+		Box2i dataWindow;
+		{
+			ImagePlug::GlobalScope globalScope( Context::current() );
+			dataWindow = parent->dataWindowPlug()->getValue();
+			h.append( dataWindow );
+		}
+
+		const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+		const int factor = 1 << mipLevel;
+		const Box2i region = BufferAlgo::intersection(
+			Box2i( tileOrigin * factor, ( tileOrigin + V2i( ImagePlug::tileSize() ) ) * factor ),
+			dataWindow
+		);
+
+		h.append( tileOrigin );
+
+		ImagePlug::ChannelDataScope tileScope( Context::current() );
+		V2i fullResolutionTileOrigin = ImagePlug::tileOrigin( region.min );
+		for( ; fullResolutionTileOrigin.y < region.max.y; fullResolutionTileOrigin.y += ImagePlug::tileSize() )
+		{
+			for( fullResolutionTileOrigin.x = ImagePlug::tileOrigin( region.min ).x; fullResolutionTileOrigin.x < region.max.x; fullResolutionTileOrigin.x += ImagePlug::tileSize() )
+			{
+				tileScope.setTileOrigin( fullResolutionTileOrigin );
+				parent->channelDataPlug()->hash( h );
+			}
+		}
+	}
+}
+
+void ImageNode::computeMipLevel( const ImagePlug *parent, Gaffer::ValuePlug *output, int mipLevel, const Gaffer::Context *context ) const
+{
+	Context::EditableScope fullResolutionScope( context );
+	fullResolutionScope.remove( ImagePlug::mipLevelContextName );
+
+	if( output == parent->formatPlug() )
+	{
+		const Format format = parent->formatPlug()->getValue();
+		static_cast<AtomicFormatPlug *>( output )->setValue(
+			Format( mipLevelBox( format.getDisplayWindow(), mipLevel ), format.getPixelAspect() )
+		);
+	}
+	else if( output == parent->dataWindowPlug() )
+	{
+		static_cast<AtomicBox2iPlug *>( output )->setValue(
+			mipLevelBox( parent->dataWindowPlug()->getValue(), mipLevel )
+		);
+	}
+	else if( output == parent->metadataPlug() )
+	{
+		static_cast<AtomicCompoundDataPlug *>( output )->setValue( parent->metadataPlug()->getValue() );
+	}
+	else if( output == parent->channelNamesPlug() )
+	{
+		static_cast<StringVectorDataPlug *>( output )->setValue( parent->channelNamesPlug()->getValue() );
+	}
+	else if( output == parent->channelDataPlug() )
+	{
+		// Each pixel is the average of the corresponding block of
+		// full resolution pixels, with pixels outside the data
+		// window treated as black.
+
+		Box2i dataWindow;
+		{
+			ImagePlug::GlobalScope globalScope( Context::current() );
+			dataWindow = parent->dataWindowPlug()->getValue();
+		}
+
+		const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+		const int tileSize = ImagePlug::tileSize();
+		const int factor = 1 << mipLevel;
+		const Box2i fullRegion( tileOrigin * factor, ( tileOrigin + V2i( tileSize ) ) * factor );
+		const Box2i region = BufferAlgo::intersection( fullRegion, dataWindow );
+		const float weight = 1.0f / (float)( factor * factor );
+
+		FloatVectorDataPtr resultData = new FloatVectorData;
+		vector<float> &result = resultData->writable();
+		result.resize( tileSize * tileSize, 0.0f );
+
+		ImagePlug::ChannelDataScope tileScope( Context::current() );
+		V2i fullResolutionTileOrigin = ImagePlug::tileOrigin( region.min );
+		for( ; fullResolutionTileOrigin.y < region.max.y; fullResolutionTileOrigin.y += tileSize )
+		{
+			for( fullResolutionTileOrigin.x = ImagePlug::tileOrigin( region.min ).x; fullResolutionTileOrigin.x < region.max.x; fullResolutionTileOrigin.x += tileSize )
+			{
+				IECore::Canceller::check( context->canceller() );
+
+				tileScope.setTileOrigin( fullResolutionTileOrigin );
+				ConstFloatVectorDataPtr tileData = parent->channelDataPlug()->getValue();
+				const vector<float> &tile = tileData->readable();
+
+				const Box2i tileRegion = BufferAlgo::intersection(
+					region, Box2i( fullResolutionTileOrigin, fullResolutionTileOrigin + V2i( tileSize ) )
+				);
+
+				for( int y = tileRegion.min.y; y < tileRegion.max.y; ++y )
+				{
+					const float *in = &tile[( y - fullResolutionTileOrigin.y ) * tileSize + tileRegion.min.x - fullResolutionTileOrigin.x];
+					float *out = &result[( ( y - fullRegion.min.y ) / factor ) * tileSize];
+					for( int x = tileRegion.min.x; x < tileRegion.max.x; ++x )
+					{
+						out[( x - fullRegion.min.x ) / factor] += *in++ * weight;
+					}
+				}
+			}
+		}
+
+		static_cast<FloatVectorDataPlug *>( output )->setValue( resultData );
+	}
+}
+
 void ImageNode::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ComputeNode::affects( input, outputs );
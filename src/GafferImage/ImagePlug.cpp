@@ -113,6 +113,7 @@ class CopyTile
 
 const IECore::InternedString ImagePlug::channelNameContextName = "image:channelName";
 const IECore::InternedString ImagePlug::tileOriginContextName = "image:tileOrigin";
+const IECore::InternedString ImagePlug::mipLevelContextName = "image:mipLevel";
 
 static ContextAlgo::GlobalScope::Registration g_globalScopeRegistration(
 	ImagePlug::staticTypeId(),
@@ -323,6 +324,77 @@ IECore::MurmurHash ImagePlug::channelDataHash( const std::string &channelName, c
 	return channelDataPlug()->hash();
 }
 
+std::vector<IECore::ConstFloatVectorDataPtr> ImagePlug::channelData( const std::vector<std::string> &channelNames, const Imath::V2i &tile ) const
+{
+	std::vector<ConstFloatVectorDataPtr> result;
+	if( direction()==In && !getInput() )
+	{
+		result.resize( channelNames.size(), channelDataPlug()->defaultValue() );
+		return result;
+	}
+
+	ConstStringVectorDataPtr existingChannelNamesData;
+	{
+		GlobalScope globalScope( Context::current() );
+		existingChannelNamesData = channelNamesPlug()->getValue();
+	}
+	const std::vector<std::string> &existingChannelNames = existingChannelNamesData->readable();
+
+	ChannelDataScope channelDataScope( Context::current() );
+	channelDataScope.setTileOrigin( tile );
+
+	result.reserve( channelNames.size() );
+	for( const auto &channelName : channelNames )
+	{
+		if( ImageAlgo::channelExists( existingChannelNames, channelName ) )
+		{
+			channelDataScope.setChannelName( channelName );
+			result.push_back( channelDataPlug()->getValue() );
+		}
+		else
+		{
+			result.push_back( blackTile() );
+		}
+	}
+
+	return result;
+}
+
+void ImagePlug::channelDataHash( const std::vector<std::string> &channelNames, const Imath::V2i &tile, IECore::MurmurHash &h ) const
+{
+	if( direction()==In && !getInput() )
+	{
+		for( size_t i = 0; i < channelNames.size(); ++i )
+		{
+			channelDataPlug()->defaultValue()->hash( h );
+		}
+		return;
+	}
+
+	ConstStringVectorDataPtr existingChannelNamesData;
+	{
+		GlobalScope globalScope( Context::current() );
+		existingChannelNamesData = channelNamesPlug()->getValue();
+	}
+	const std::vector<std::string> &existingChannelNames = existingChannelNamesData->readable();
+
+	ChannelDataScope channelDataScope( Context::current() );
+	channelDataScope.setTileOrigin( tile );
+
+	for( const auto &channelName : channelNames )
+	{
+		if( ImageAlgo::channelExists( existingChannelNames, channelName ) )
+		{
+			channelDataScope.setChannelName( channelName );
+			channelDataPlug()->hash( h );
+		}
+		else
+		{
+			blackTile()->hash( h );
+		}
+	}
+}
+
 IECoreImage::ImagePrimitivePtr ImagePlug::image() const
 {
 	Format format = formatPlug()->getValue();
@@ -139,6 +139,11 @@ void ImageSampler::hash( const Gaffer::ValuePlug *output, const Gaffer::Context
 
 	if( output->parent<Plug>() == colorPlug() )
 	{
+		// Our output is not an image, so we always sample the
+		// full resolution image. See `ImagePlug::mipLevelContextName`.
+		Context::EditableScope fullResolutionScope( context );
+		fullResolutionScope.remove( ImagePlug::mipLevelContextName );
+
 		std::string channel = channelName( output );
 		if( channel.size() )
 		{
@@ -160,6 +165,9 @@ void ImageSampler::compute( Gaffer::ValuePlug *output, const Gaffer::Context *co
 	{
 		float sample = 0;
 
+		Context::EditableScope fullResolutionScope( context );
+		fullResolutionScope.remove( ImagePlug::mipLevelContextName );
+
 		std::string channel = channelName( output );
 		if( channel.size() )
 		{
@@ -38,13 +38,16 @@
 
 #include "GafferImage/FormatPlug.h"
 #include "GafferImage/ImageAlgo.h"
-#include "GafferImage/Sampler.h"
 
 #include "Gaffer/BoxPlug.h"
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/TypedPlug.h"
 
+#include "IECore/SimpleTypedData.h"
+
 using namespace std;
+using namespace Imath;
+using namespace IECore;
 using namespace Gaffer;
 using namespace GafferImage;
 
@@ -100,6 +103,8 @@ ImageStats::ImageStats( const std::string &name )
 	addChild( new Color4fPlug( "average", Gaffer::Plug::Out, Imath::Color4f( 0, 0, 0, 1 ) ) );
 	addChild( new Color4fPlug( "min", Gaffer::Plug::Out, Imath::Color4f( 0, 0, 0, 1 ) ) );
 	addChild( new Color4fPlug( "max", Gaffer::Plug::Out, Imath::Color4f( 0, 0, 0, 1 ) ) );
+	addChild( new ObjectPlug( "__tileStats", Gaffer::Plug::Out, new V3dData() ) );
+	addChild( new ObjectPlug( "__allStats", Gaffer::Plug::Out, new V3dData() ) );
 }
 
 ImageStats::~ImageStats()
@@ -166,13 +171,50 @@ const Color4fPlug *ImageStats::maxPlug() const
 	return getChild<Color4fPlug>( g_firstPlugIndex + 5 );
 }
 
+ObjectPlug *ImageStats::tileStatsPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 6 );
+}
+
+const ObjectPlug *ImageStats::tileStatsPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 6 );
+}
+
+ObjectPlug *ImageStats::allStatsPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 7 );
+}
+
+const ObjectPlug *ImageStats::allStatsPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 7 );
+}
+
 void ImageStats::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ComputeNode::affects( input, outputs );
+
 	if(
 		input == inPlug()->dataWindowPlug() ||
-		input == inPlug()->channelNamesPlug() ||
 		input == inPlug()->channelDataPlug() ||
+		areaPlug()->isAncestorOf( input )
+	)
+	{
+		outputs.push_back( tileStatsPlug() );
+	}
+
+	if(
+		input == tileStatsPlug() ||
+		areaPlug()->isAncestorOf( input )
+	)
+	{
+		outputs.push_back( allStatsPlug() );
+	}
+
+	if(
+		input == allStatsPlug() ||
+		input == inPlug()->channelNamesPlug() ||
 		input == channelsPlug() ||
 		areaPlug()->isAncestorOf( input )
 	)
@@ -183,7 +225,6 @@ void ImageStats::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 			outputs.push_back( averagePlug()->getChild(i) );
 			outputs.push_back( maxPlug()->getChild(i) );
 		}
-		return;
 	}
 }
 
@@ -191,6 +232,55 @@ void ImageStats::hash( const ValuePlug *output, const Context *context, IECore::
 {
 	ComputeNode::hash( output, context, h);
 
+	if( output == tileStatsPlug() )
+	{
+		const V2i &tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+		const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+
+		Box2i area;
+		Box2i dataWindow;
+		{
+			ImagePlug::GlobalScope globalScope( context );
+			area = areaPlug()->getValue();
+			dataWindow = inPlug()->dataWindowPlug()->getValue();
+		}
+
+		// Note that we deliberately hash only the part of the area
+		// within this tile, so that the hash of interior tiles is
+		// unaffected when the area changes.
+		const Box2i tileArea = BufferAlgo::intersection( area, tileBound );
+		const Box2i validArea = BufferAlgo::intersection( tileArea, dataWindow );
+		h.append( tileArea );
+		h.append( validArea );
+		if( !BufferAlgo::empty( validArea ) )
+		{
+			inPlug()->channelDataPlug()->hash( h );
+		}
+		return;
+	}
+	else if( output == allStatsPlug() )
+	{
+		Box2i area;
+		{
+			ImagePlug::GlobalScope globalScope( context );
+			area = areaPlug()->getValue();
+		}
+		h.append( area );
+
+		ImageAlgo::parallelGatherTiles(
+			inPlug(),
+			[ this ] ( const ImagePlug *imagePlug, const V2i &tileOrigin ) {
+				return tileStatsPlug()->hash();
+			},
+			[ &h ] ( const ImagePlug *imagePlug, const V2i &tileOrigin, const IECore::MurmurHash &tileHash ) {
+				h.append( tileHash );
+			},
+			area,
+			ImageAlgo::TopToBottom
+		);
+		return;
+	}
+
 	const int colorIndex = ::colorIndex( output );
 	if( colorIndex == -1 )
 	{
@@ -198,6 +288,11 @@ void ImageStats::hash( const ValuePlug *output, const Context *context, IECore::
 		return;
 	}
 
+	// Our outputs are not images, so are always computed
+	// from the full resolution image. See `ImagePlug::mipLevelContextName`.
+	ImagePlug::ChannelDataScope channelDataScope( context );
+	channelDataScope.remove( ImagePlug::mipLevelContextName );
+
 	const std::string channelName = this->channelName( colorIndex );
 	const Imath::Box2i area = areaPlug()->getValue();
 
@@ -207,12 +302,93 @@ void ImageStats::hash( const ValuePlug *output, const Context *context, IECore::
 		return;
 	}
 
-	Sampler s( inPlug(), channelName, area );
-	s.hash( h );
+	channelDataScope.setChannelName( channelName );
+	allStatsPlug()->hash( h );
 }
 
 void ImageStats::compute( ValuePlug *output, const Context *context ) const
 {
+	if( output == tileStatsPlug() )
+	{
+		const V2i &tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+		const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+
+		Box2i area;
+		Box2i dataWindow;
+		{
+			ImagePlug::GlobalScope globalScope( context );
+			area = areaPlug()->getValue();
+			dataWindow = inPlug()->dataWindowPlug()->getValue();
+		}
+
+		const Box2i tileArea = BufferAlgo::intersection( area, tileBound );
+		const Box2i validArea = BufferAlgo::intersection( tileArea, dataWindow );
+
+		double min = limits<double>::max();
+		double max = -limits<double>::max();
+		double sum = 0.;
+
+		if( !BufferAlgo::empty( validArea ) )
+		{
+			ConstFloatVectorDataPtr channelData = inPlug()->channelDataPlug()->getValue();
+			const vector<float> &channel = channelData->readable();
+
+			for( int y = validArea.min.y; y < validArea.max.y; ++y )
+			{
+				const float *v = &channel[BufferAlgo::index( V2i( validArea.min.x, y ), tileBound )];
+				for( int x = validArea.min.x; x < validArea.max.x; ++x, ++v )
+				{
+					min = std::min( (double)*v, min );
+					max = std::max( (double)*v, max );
+					sum += *v;
+				}
+			}
+		}
+
+		if( validArea != tileArea )
+		{
+			// Pixels outside the data window are black.
+			min = std::min( 0., min );
+			max = std::max( 0., max );
+		}
+
+		static_cast<ObjectPlug *>( output )->setValue( new V3dData( V3d( min, max, sum ) ) );
+		return;
+	}
+	else if( output == allStatsPlug() )
+	{
+		Box2i area;
+		{
+			ImagePlug::GlobalScope globalScope( context );
+			area = areaPlug()->getValue();
+		}
+
+		double min = limits<double>::max();
+		double max = -limits<double>::max();
+		double sum = 0.;
+
+		// We gather in order rather than as tiles become available,
+		// so that the floating point summation is deterministic.
+		ImageAlgo::parallelGatherTiles(
+			inPlug(),
+			[ this ] ( const ImagePlug *imagePlug, const V2i &tileOrigin ) {
+				return boost::static_pointer_cast<const V3dData>( tileStatsPlug()->getValue() );
+			},
+			[ &min, &max, &sum ] ( const ImagePlug *imagePlug, const V2i &tileOrigin, ConstV3dDataPtr tileStats ) {
+				const V3d &s = tileStats->readable();
+				min = std::min( s[0], min );
+				max = std::max( s[1], max );
+				sum += s[2];
+			},
+			area,
+			ImageAlgo::TopToBottom
+		);
+
+		const double average = sum / ( double( area.size().x ) * double( area.size().y ) );
+		static_cast<ObjectPlug *>( output )->setValue( new V3dData( V3d( min, max, average ) ) );
+		return;
+	}
+
 	const int colorIndex = ::colorIndex( output );
 	if( colorIndex == -1 )
 	{
@@ -221,6 +397,9 @@ void ImageStats::compute( ValuePlug *output, const Context *context ) const
 		return;
 	}
 
+	ImagePlug::ChannelDataScope channelDataScope( context );
+	channelDataScope.remove( ImagePlug::mipLevelContextName );
+
 	const std::string channelName = this->channelName( colorIndex );
 	const Imath::Box2i area = areaPlug()->getValue();
 
@@ -230,37 +409,23 @@ void ImageStats::compute( ValuePlug *output, const Context *context ) const
 		return;
 	}
 
-	// Loop over the ROI and compute the min, max and average channel values and then set our outputs.
-	Sampler s( inPlug(), channelName, area );
-
-	float min = Imath::limits<float>::max();
-	float max = Imath::limits<float>::min();
-	double sum = 0.;
-
-	for( int y = area.min.y; y < area.max.y; ++y )
+	ConstV3dDataPtr allStats;
 	{
-		for( int x = area.min.x; x < area.max.x; ++x )
-		{
-			float v = s.sample( x, y );
-			min = std::min( v, min );
-			max = std::max( v, max );
-			sum += v;
-		}
+		channelDataScope.setChannelName( channelName );
+		allStats = boost::static_pointer_cast<const V3dData>( allStatsPlug()->getValue() );
 	}
 
 	if( output->parent<Plug>() == minPlug() )
 	{
-		static_cast<FloatPlug *>( output )->setValue( min );
+		static_cast<FloatPlug *>( output )->setValue( allStats->readable()[0] );
 	}
 	else if( output->parent<Plug>() == maxPlug() )
 	{
-		static_cast<FloatPlug *>( output )->setValue( max );
+		static_cast<FloatPlug *>( output )->setValue( allStats->readable()[1] );
 	}
 	else if( output->parent<Plug>() == averagePlug() )
 	{
-		static_cast<FloatPlug *>( output )->setValue(
-			sum / double( (area.size().x) * (area.size().y) )
-		);
+		static_cast<FloatPlug *>( output )->setValue( allStats->readable()[2] );
 	}
 }
 
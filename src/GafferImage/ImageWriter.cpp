@@ -140,36 +140,41 @@ class FlatTileWriter
 	// possibility that multiple output tiles may be contained within a single
 	// Gaffer tile.
 	//
-	// The instance of the class stores a vector of tile data storage vectors,
-	// all of which start off empty. We only allocate the space for the tiles
-	// when we need to start filling them, and free the space once the tiles
-	// have been written to the ImageOutput. We also store a vector of bool
-	// values (m_tilesFilled) to determine which output tiles have been filled
-	// with data, and are therefore ready to write.
+	// The instance of the class stores a vector of data storage vectors, one
+	// per row of output tiles, all of which start off empty. We only allocate
+	// the space for a row when we need to start filling it, and free the
+	// space once the row has been written to the ImageOutput. We also store a
+	// vector of bool values (m_tilesFilled) to determine which output tiles
+	// have been filled with data.
 	//
-	// The instance stores the index (m_nextTileIndex) of the next output tile
-	// that it is expecting to write. This is because some formats require
-	// tiles to be written in order, and we are holding to that for all
+	// The instance stores the index (m_nextRowIndex) of the next row of
+	// output tiles that it is expecting to write. This is because some formats
+	// require tiles to be written in order, and we are holding to that for all
 	// formats.
 	//
-	// As Gaffer tiles are passed in, the data is copied into any output tiles
+	// As Gaffer tiles are passed in, the data is copied into any output rows
 	// they intersect with. Once that is done, any output tiles whose bottom
-	// right corners are above and to the left (or equal) to the bottom right
-	// corner of the tile we've just written can be considered to be filled,
-	// so set the appropriate m_tilesFilled value.
+	// right corners (clipped to the process window) are above and to the left
+	// (or equal) to the bottom right corner of the tile we've just written can
+	// be considered to be filled, so set the appropriate m_tilesFilled value.
+	// Because the Gaffer tiles arrive from the top down, this means that each
+	// row is written and freed as soon as it is complete, and at most two rows
+	// of output tiles are held in memory at once, however the output tiles
+	// line up with the Gaffer tiles.
 	//
-	// After flagging filled tiles, it iterates through tiles, starting at
-	// m_nextTileIndex, and for each tile, if the tile is marked as filled,
-	// write it, and if the tile does not intersect the region covered by the
-	// input tiles, write a black tile. If neither of these is the case, stop,
-	// and set m_nextTileIndex to the tile that it stopped on, which is the
-	// next tile to write.
+	// After flagging filled tiles, it iterates through rows, starting at
+	// m_nextRowIndex, and writes each row in which every tile is either
+	// filled or does not intersect the region covered by the input tiles.
+	// Rows are written with a single call to `write_tiles()` rather than one
+	// call per tile, so that formats such as OpenEXR can compress all the
+	// tiles in the row in parallel on their own thread pool, while
+	// parallelGatherTiles continues to compute subsequent tiles upstream.
 	//
 	// Once all Gaffer tiles have been processed, there may still be partially
-	// unfilled tiles, which will be fine, as their unfilled areas will be
-	// black, which is what we want. So iterate over the remaining tiles, and
-	// if memory has been allocated for that tile, write it to the file, and if
-	// nothing has been allocated, write a black tile.
+	// unfilled rows, which will be fine, as their unfilled areas will be
+	// black, which is what we want. So iterate over the remaining rows, and
+	// if memory has been allocated for that row, write it to the file, and if
+	// nothing has been allocated, write a black row.
 	public:
 		FlatTileWriter(
 				ImageOutputPtr out,
@@ -185,35 +190,28 @@ class FlatTileWriter
 				m_inputTilesBounds( Imath::Box2i( ImagePlug::tileOrigin( processWindow.min ), ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) + Imath::V2i( ImagePlug::tileSize() ) ) ),
 				m_outputDataWindow( m_format.fromEXRSpace( Imath::Box2i( Imath::V2i( m_spec.x, m_spec.y ), Imath::V2i( m_spec.x + m_spec.width - 1, m_spec.y + m_spec.height - 1 ) ) ) ),
 				m_numTiles( Imath::V2i( (int)ceil( float( m_spec.width ) / m_spec.tile_width ), (int)ceil( float( m_spec.height ) / m_spec.tile_height ) ) ),
-				m_nextTileIndex( 0 ),
-				m_blackTile( nullptr )
+				m_nextRowIndex( 0 ),
+				m_blackRow( nullptr )
 		{
-			m_tilesData.resize( m_numTiles.x * m_numTiles.y );
+			m_rowsData.resize( m_numTiles.y );
 			m_tilesFilled.resize( m_numTiles.x * m_numTiles.y, false );
 
-			for( size_t i = 0; i < m_tilesData.size(); ++i )
+			for( size_t i = 0; i < m_rowsData.size(); ++i )
 			{
-				m_tilesData[i] = new FloatVectorData;
+				m_rowsData[i] = new FloatVectorData;
 			}
 		}
 
 		void finish()
 		{
-			for( size_t tileIndex = m_nextTileIndex; tileIndex < m_tilesData.size(); ++tileIndex )
+			for( size_t rowIndex = m_nextRowIndex; rowIndex < m_rowsData.size(); ++rowIndex )
 			{
-				Imath::V2i tileOrigin = outTileOrigin( tileIndex );
-				if( !m_tilesData[tileIndex]->readable().empty() )
-				{
-					writeTile( tileOrigin, m_tilesData[tileIndex] );
-				}
-				else
-				{
-					// If the tileData object hasn't been resized, then
-					// we have never even tried to write data to this
-					// tile, so write the static black tile.
-					writeTile( tileOrigin, blackTile() );
-				}
+				// If the rowData object hasn't been resized, then
+				// we have never even tried to write data to this
+				// row, and `writeRow()` will use the static black row.
+				writeRow( rowIndex );
 			}
+			m_nextRowIndex = m_rowsData.size();
 		}
 
 		void operator()( const ImagePlug *imagePlug, const string &channelName, const V2i &tileOrigin, ConstFloatVectorDataPtr data )
@@ -224,25 +222,24 @@ class FlatTileWriter
 
 			Box2i tilesWrite = BufferAlgo::intersection( outTilesBounds(), Imath::Box2i( outTileOrigin( inTileBounds.min ), outTileOrigin( inTileBounds.max - Imath::V2i( 1 ) ) + Imath::V2i( m_spec.tile_width, m_spec.tile_height ) ) );
 
-			Imath::V2i outTileOrig( tilesWrite.min.x, tilesWrite.max.y - m_spec.tile_height );
-
-			for( ; outTileOrig.y >= tilesWrite.min.y; outTileOrig.y -= m_spec.tile_height )
+			for( int outRowOriginY = tilesWrite.max.y - m_spec.tile_height; outRowOriginY >= tilesWrite.min.y; outRowOriginY -= m_spec.tile_height )
 			{
-				for( outTileOrig.x = tilesWrite.min.x; outTileOrig.x < tilesWrite.max.x; outTileOrig.x += m_spec.tile_width )
-				{
-					size_t tileIndex = outTileIndex( outTileOrig );
-					Imath::Box2i outTileBnds = outTileBounds( outTileOrig );
+				const size_t rowIndex = outTileIndex( Imath::V2i( m_outputDataWindow.min.x, outRowOriginY ) ) / m_numTiles.x;
+				const Imath::Box2i outRowBnds = outRowBounds( rowIndex );
 
-					vector<float> &tile = m_tilesData[tileIndex]->writable();
-					if( tile.empty() )
-					{
-						tile.resize( m_spec.tile_width * m_spec.tile_height * m_spec.channelnames.size(), 0. );
-					}
-
-					Imath::Box2i copyArea( BufferAlgo::intersection( m_processWindow, BufferAlgo::intersection( inTileBounds, outTileBnds ) ) );
+				const Imath::Box2i copyArea( BufferAlgo::intersection( m_processWindow, BufferAlgo::intersection( inTileBounds, outRowBnds ) ) );
+				if( BufferAlgo::empty( copyArea ) )
+				{
+					continue;
+				}
 
-					copyBufferArea( &data->readable()[0], inTileBounds, &tile[0], outTileBnds, channelIndex, m_spec.channelnames.size(), true, copyArea );
+				vector<float> &row = m_rowsData[rowIndex]->writable();
+				if( row.empty() )
+				{
+					row.resize( outRowBnds.size().x * outRowBnds.size().y * m_spec.channelnames.size(), 0. );
 				}
+
+				copyBufferArea( &data->readable()[0], inTileBounds, &row[0], outRowBnds, channelIndex, m_spec.channelnames.size(), true, copyArea );
 			}
 
 			if( lastChannelOfTile( channelIndex ) )
@@ -250,19 +247,19 @@ class FlatTileWriter
 				flagFilledTiles( inTileBounds );
 			}
 
-			writeFilledTiles();
+			writeFilledRows();
 		}
 
 	private:
 
-		inline ConstFloatVectorDataPtr blackTile()
+		inline ConstFloatVectorDataPtr blackRow()
 		{
-			if( m_blackTile == nullptr )
+			if( m_blackRow == nullptr )
 			{
-				m_blackTile = new IECore::FloatVectorData( std::vector<float>( m_spec.tile_width * m_spec.tile_height * m_spec.channelnames.size(), 0. ) );
+				m_blackRow = new IECore::FloatVectorData( std::vector<float>( m_numTiles.x * m_spec.tile_width * m_spec.tile_height * m_spec.channelnames.size(), 0. ) );
 			}
 
-			return m_blackTile;
+			return m_blackRow;
 		}
 
 		inline size_t outTileIndex( const Imath::V2i &tileOrigin ) const
@@ -295,6 +292,12 @@ class FlatTileWriter
 			return Imath::Box2i( outTileOrigin( m_outputDataWindow.min ), outTileOrigin( m_outputDataWindow.max - Imath::V2i( 1 ) ) + Imath::V2i( m_spec.tile_width, m_spec.tile_height) );
 		}
 
+		inline Imath::Box2i outRowBounds( const size_t rowIndex ) const
+		{
+			Imath::V2i origin = outTileOrigin( rowIndex * m_numTiles.x );
+			return Imath::Box2i( origin, origin + Imath::V2i( m_numTiles.x * m_spec.tile_width, m_spec.tile_height ) );
+		}
+
 		inline bool firstChannelOfTile( const size_t channelIndex )
 		{
 			return channelIndex == 0;
@@ -307,12 +310,21 @@ class FlatTileWriter
 
 		void flagFilledTiles( const Imath::Box2i &inTileBounds )
 		{
-			for( size_t i = m_nextTileIndex; i < m_tilesData.size(); ++i )
+			for( size_t i = m_nextRowIndex * m_numTiles.x; i < m_tilesFilled.size(); ++i )
 			{
 				if( !m_tilesFilled[i] )
 				{
-					Imath::Box2i outTileBnds( outTileBounds( outTileOrigin( i ) ) );
-					if( inTileBounds.max.x >= outTileBnds.max.x && inTileBounds.min.y <= outTileBnds.min.y )
+					// We only ever receive data within the process window, so
+					// we must compare against the part of the output tile that
+					// lies within it. Comparing against the whole tile would
+					// mean that tiles overhanging the right or bottom edge of
+					// the last Gaffer tile are never flagged, leaving every
+					// subsequent row resident until `finish()`.
+					const Imath::Box2i outTileBnds( BufferAlgo::intersection( m_processWindow, outTileBounds( outTileOrigin( i ) ) ) );
+					if(
+						BufferAlgo::empty( outTileBnds ) ||
+						( inTileBounds.max.x >= outTileBnds.max.x && inTileBounds.min.y <= outTileBnds.min.y )
+					)
 					{
 						m_tilesFilled[i] = true;
 					}
@@ -324,40 +336,52 @@ class FlatTileWriter
 			}
 		}
 
-		void writeFilledTiles()
+		bool rowReady( const size_t rowIndex ) const
 		{
-			size_t tileIndex;
-			for( tileIndex = m_nextTileIndex; tileIndex < m_tilesData.size(); ++tileIndex )
+			for( size_t tileIndex = rowIndex * m_numTiles.x, e = tileIndex + m_numTiles.x; tileIndex < e; ++tileIndex )
 			{
-				Imath::V2i tileOrigin = outTileOrigin( tileIndex );
-
-				if( m_tilesFilled[tileIndex] )
-				{
-					writeTile( tileOrigin, m_tilesData[tileIndex] );
-					m_tilesData[tileIndex].reset();
-				}
-				else if( !BufferAlgo::intersects( m_inputTilesBounds, outTileBounds( tileOrigin ) ) )
+				if( !m_tilesFilled[tileIndex] && BufferAlgo::intersects( m_inputTilesBounds, outTileBounds( outTileOrigin( tileIndex ) ) ) )
 				{
-					writeTile( tileOrigin, blackTile() );
+					return false;
 				}
-				else
+			}
+			return true;
+		}
+
+		void writeFilledRows()
+		{
+			for( ; m_nextRowIndex < m_rowsData.size(); ++m_nextRowIndex )
+			{
+				if( !rowReady( m_nextRowIndex ) )
 				{
 					break;
 				}
+				writeRow( m_nextRowIndex );
 			}
-
-			m_nextTileIndex = tileIndex;
 		}
 
-
-		void writeTile( const Imath::V2i &tileOrigin, ConstFloatVectorDataPtr tileData ) const
+		void writeRow( const size_t rowIndex )
 		{
-			Imath::V2i exrTileOrigin = m_format.toEXRSpace( tileOrigin + Imath::V2i( 0, m_spec.tile_height - 1 ) );
+			ConstFloatVectorDataPtr rowData = m_rowsData[rowIndex];
+			if( rowData->readable().empty() )
+			{
+				rowData = blackRow();
+			}
+
+			// The row buffer always holds whole tiles, but the last column and
+			// row of tiles may extend beyond the data window. Explicit strides
+			// allow us to pass the clipped region straight to the ImageOutput.
+			const Imath::V2i exrRowOrigin = m_format.toEXRSpace( outTileOrigin( rowIndex * m_numTiles.x ) + Imath::V2i( 0, m_spec.tile_height - 1 ) );
+			const int exrRowEndY = std::min( exrRowOrigin.y + m_spec.tile_height, m_spec.y + m_spec.height );
+			const stride_t xStride = m_spec.channelnames.size() * sizeof( float );
+			const stride_t yStride = m_numTiles.x * m_spec.tile_width * xStride;
 
-			if( !m_out->write_tile( exrTileOrigin.x, exrTileOrigin.y, 0, TypeDesc::FLOAT, &tileData->readable()[0] ) )
+			if( !m_out->write_tiles( exrRowOrigin.x, m_spec.x + m_spec.width, exrRowOrigin.y, exrRowEndY, 0, 1, TypeDesc::FLOAT, &rowData->readable()[0], xStride, yStride ) )
 			{
-				throw IECore::Exception( boost::str( boost::format( "Could not write tile to \"%s\", error = %s" ) % m_fileName % m_out->geterror() ) );
+				throw IECore::Exception( boost::str( boost::format( "Could not write tiles to \"%s\", error = %s" ) % m_fileName % m_out->geterror() ) );
 			}
+
+			m_rowsData[rowIndex].reset();
 		}
 
 		ImageOutputPtr m_out;
@@ -368,10 +392,10 @@ class FlatTileWriter
 		const Imath::Box2i m_inputTilesBounds;
 		const Imath::Box2i m_outputDataWindow;
 		const Imath::V2i m_numTiles;
-		size_t m_nextTileIndex;
-		std::vector<FloatVectorDataPtr> m_tilesData;
+		size_t m_nextRowIndex;
+		std::vector<FloatVectorDataPtr> m_rowsData;
 		std::vector<bool> m_tilesFilled;
-		ConstFloatVectorDataPtr m_blackTile;
+		ConstFloatVectorDataPtr m_blackRow;
 };
 
 class FlatScanlineWriter
@@ -106,6 +106,14 @@ const Gaffer::IntPlug *Merge::operationPlug() const
 	return getChild<IntPlug>( g_firstPlugIndex );
 }
 
+bool Merge::supportsMipLevels() const
+{
+	// Add and Subtract are exact. Operations which multiply the inputs
+	// together or by alpha, such as Multiply and Over, are approximate
+	// at reduced resolution.
+	return true;
+}
+
 void Merge::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -58,6 +58,11 @@ MetadataProcessor::~MetadataProcessor()
 {
 }
 
+bool MetadataProcessor::supportsMipLevels() const
+{
+	return true;
+}
+
 void MetadataProcessor::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -102,6 +102,13 @@ const Gaffer::StringPlug *Mix::maskChannelPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 2 );
 }
 
+bool Mix::supportsMipLevels() const
+{
+	// Only exact when there is no mask, since blending by a filtered mask
+	// differs from filtering the blend.
+	return true;
+}
+
 void Mix::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -38,6 +38,7 @@
 
 #include "Gaffer/Context.h"
 
+#include "IECore/LRUCache.h"
 #include "IECore/SimpleTypedData.h"
 
 #include "tbb/mutex.h"
@@ -66,6 +67,47 @@ typedef tbb::null_mutex OCIOMutex;
 
 static OCIOMutex g_ocioMutex;
 
+// Creating a processor can be expensive, and a single image will
+// typically need the same processor for every tile, so we cache them.
+// The cache is keyed on the hash of the transform, the type of the
+// node that provided it, and the OpenColorIO cache ID for the config
+// and context.
+
+struct ProcessorCacheGetterKey
+{
+
+	ProcessorCacheGetterKey()
+	{
+	}
+
+	ProcessorCacheGetterKey( const MurmurHash &transformHash, OpenColorIO::ConstConfigRcPtr config, OpenColorIO::ConstContextRcPtr context, OpenColorIO::ConstTransformRcPtr transform )
+		:	config( config ), context( context ), transform( transform ), hash( transformHash )
+	{
+		hash.append( config->getCacheID( context ) );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	OpenColorIO::ConstConfigRcPtr config;
+	OpenColorIO::ConstContextRcPtr context;
+	OpenColorIO::ConstTransformRcPtr transform;
+	MurmurHash hash;
+
+};
+
+OpenColorIO::ConstProcessorRcPtr processorGetter( const ProcessorCacheGetterKey &key, size_t &cost )
+{
+	cost = 1;
+	OCIOMutex::scoped_lock lock( g_ocioMutex );
+	return key.config->getProcessor( key.context, key.transform, OpenColorIO::TRANSFORM_DIR_FORWARD );
+}
+
+typedef LRUCache<IECore::MurmurHash, OpenColorIO::ConstProcessorRcPtr, LRUCachePolicy::Parallel, ProcessorCacheGetterKey> ProcessorCache;
+ProcessorCache g_processorCache( processorGetter, 1000 );
+
 } // namespace
 
 IE_CORE_DEFINERUNTIMETYPED( OpenColorIOTransform );
@@ -197,9 +239,11 @@ OpenColorIO::ConstContextRcPtr OpenColorIOTransform::ocioContext(OpenColorIO::Co
 void OpenColorIOTransform::processColorData( const Gaffer::Context *context, IECore::FloatVectorData *r, IECore::FloatVectorData *g, IECore::FloatVectorData *b ) const
 {
 	OpenColorIO::ConstTransformRcPtr colorTransform;
+	MurmurHash transformHash;
 	{
 		ImagePlug::GlobalScope c( context );
 		colorTransform = transform();
+		hashTransform( context, transformHash );
 	}
 
 	if( !colorTransform )
@@ -207,14 +251,20 @@ void OpenColorIOTransform::processColorData( const Gaffer::Context *context, IEC
 		return;
 	}
 
-	OpenColorIO::ConstProcessorRcPtr processor;
+	// The cache is shared by all subclasses, but `hashTransform()` is only
+	// required to be unique for a particular subclass, so we must also
+	// distinguish between the types of node.
+	transformHash.append( typeId() );
+
+	ProcessorCacheGetterKey processorKey;
 	{
 		OCIOMutex::scoped_lock lock( g_ocioMutex );
 		OpenColorIO::ConstConfigRcPtr config = OpenColorIO::GetCurrentConfig();
-		OpenColorIO::ConstContextRcPtr context = ocioContext( config );
-		processor = config->getProcessor( context, colorTransform, OpenColorIO::TRANSFORM_DIR_FORWARD );
+		processorKey = ProcessorCacheGetterKey( transformHash, config, ocioContext( config ), colorTransform );
 	}
 
+	OpenColorIO::ConstProcessorRcPtr processor = g_processorCache.get( processorKey );
+
 	OpenColorIO::PlanarImageDesc image(
 		r->baseWritable(),
 		g->baseWritable(),
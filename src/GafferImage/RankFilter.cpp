@@ -42,6 +42,8 @@
 
 #include <algorithm>
 #include <climits>
+#include <cmath>
+#include <numeric>
 
 using namespace std;
 using namespace Imath;
@@ -49,6 +51,220 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferImage;
 
+//////////////////////////////////////////////////////////////////////////
+// Utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Limits the memory used by `medianTile()`, which ranks every pixel
+// in the input region. This corresponds to a radius of around 480.
+const int g_maxSlidingMedianPixels = 1024 * 1024;
+
+struct Min
+{
+	float operator()( float a, float b ) const { return std::min( a, b ); }
+};
+
+struct Max
+{
+	float operator()( float a, float b ) const { return std::max( a, b ); }
+};
+
+// Computes the extreme value of every window of `2 * radius + 1`
+// consecutive values from `in`, using the van Herk/Gil-Werman algorithm.
+// This requires only three comparisons per value, however large the
+// radius. `in` must hold `size + 2 * radius` values, where `size` is the
+// number of values written to `out`, each `outStride` apart.
+template<typename Op>
+void slidingExtreme( const vector<float> &in, int radius, int size, vector<float> &prefix, vector<float> &suffix, float *out, int outStride, Op op )
+{
+	const int windowSize = 2 * radius + 1;
+	const int n = in.size();
+
+	prefix.resize( n );
+	suffix.resize( n );
+
+	// The extreme of each block of `windowSize` values, accumulated
+	// forwards in `prefix` and backwards in `suffix`. Any window then
+	// spans at most two blocks.
+	for( int i = 0; i < n; ++i )
+	{
+		prefix[i] = i % windowSize ? op( prefix[i-1], in[i] ) : in[i];
+	}
+	for( int i = n - 1; i >= 0; --i )
+	{
+		suffix[i] = ( i == n - 1 || ( i + 1 ) % windowSize == 0 ) ? in[i] : op( suffix[i+1], in[i] );
+	}
+
+	for( int i = 0; i < size; ++i, out += outStride )
+	{
+		*out = op( suffix[i], prefix[i + windowSize - 1] );
+	}
+}
+
+// Two level histogram of ranks, allowing the k'th smallest rank
+// currently in the histogram to be found in `O( sqrt( n ) )`.
+class RankHistogram
+{
+
+	public :
+
+		RankHistogram( int n )
+			:	m_binSize( std::max( 1, (int)sqrtf( n ) ) ), m_fine( n, 0 ), m_coarse( n / m_binSize + 1, 0 )
+		{
+		}
+
+		void add( int rank )
+		{
+			m_fine[rank]++;
+			m_coarse[rank / m_binSize]++;
+		}
+
+		void remove( int rank )
+		{
+			m_fine[rank]--;
+			m_coarse[rank / m_binSize]--;
+		}
+
+		int nth( int k ) const
+		{
+			int bin = 0;
+			while( k >= m_coarse[bin] )
+			{
+				k -= m_coarse[bin++];
+			}
+			int rank = bin * m_binSize;
+			while( k >= m_fine[rank] )
+			{
+				k -= m_fine[rank++];
+			}
+			return rank;
+		}
+
+	private :
+
+		const int m_binSize;
+		vector<int> m_fine;
+		vector<int> m_coarse;
+
+};
+
+// Unlike `operator <`, provides the strict weak ordering required
+// by `std::sort()` and `std::nth_element()` even when NaNs are present.
+// NaNs are ordered after all other values.
+bool lessWithNaNsLast( float a, float b )
+{
+	if( std::isnan( a ) )
+	{
+		return false;
+	}
+	return std::isnan( b ) || a < b;
+}
+
+// Computes the median of every window of `( 2 * radius.x + 1 ) * ( 2 * radius.y + 1 )`
+// pixels for a tile, using Huang's sliding histogram algorithm. Because our
+// values are floating point, we first replace them with their ranks within
+// the input region, so they can be binned exactly. Moving the window by one
+// pixel then costs `O( radius )` rather than the `O( radius^2 )` required to
+// visit every pixel in the window.
+void medianTile( Sampler &sampler, const Box2i &tileBound, const V2i &radius, const Context *context, vector<float> &result )
+{
+	const Box2i inputBound( tileBound.min - radius, tileBound.max + radius );
+	const int inputWidth = inputBound.size().x;
+	const int n = inputBound.size().x * inputBound.size().y;
+
+	vector<float> values;
+	values.reserve( n );
+	for( int y = inputBound.min.y; y < inputBound.max.y; ++y )
+	{
+		IECore::Canceller::check( context->canceller() );
+		for( int x = inputBound.min.x; x < inputBound.max.x; ++x )
+		{
+			values.push_back( sampler.sample( x, y ) );
+		}
+	}
+
+	vector<int> order( n );
+	std::iota( order.begin(), order.end(), 0 );
+	std::sort(
+		order.begin(), order.end(),
+		[&values]( int a, int b ) -> bool {
+			if( lessWithNaNsLast( values[a], values[b] ) )
+			{
+				return true;
+			}
+			else if( lessWithNaNsLast( values[b], values[a] ) )
+			{
+				return false;
+			}
+			return a < b;
+		}
+	);
+
+	vector<int> ranks( n );
+	vector<float> sortedValues( n );
+	for( int i = 0; i < n; ++i )
+	{
+		ranks[order[i]] = i;
+		sortedValues[i] = values[order[i]];
+	}
+
+	const int tileSize = ImagePlug::tileSize();
+	const int k = ( ( 2 * radius.x + 1 ) * ( 2 * radius.y + 1 ) ) / 2;
+	result.resize( tileSize * tileSize );
+
+	RankHistogram histogram( n );
+	for( int y = 0; y <= 2 * radius.y; ++y )
+	{
+		for( int x = 0; x <= 2 * radius.x; ++x )
+		{
+			histogram.add( ranks[y * inputWidth + x] );
+		}
+	}
+
+	// We traverse the tile in a zigzag, so that the window only
+	// ever moves by a single pixel.
+	for( int y = 0; y < tileSize; ++y )
+	{
+		IECore::Canceller::check( context->canceller() );
+
+		const bool leftToRight = y % 2 == 0;
+		if( y > 0 )
+		{
+			const int x = leftToRight ? 0 : tileSize - 1;
+			for( int wx = x; wx <= x + 2 * radius.x; ++wx )
+			{
+				histogram.remove( ranks[( y - 1 ) * inputWidth + wx] );
+				histogram.add( ranks[( y + 2 * radius.y ) * inputWidth + wx] );
+			}
+		}
+
+		for( int i = 0; i < tileSize; ++i )
+		{
+			const int x = leftToRight ? i : tileSize - 1 - i;
+			if( i > 0 )
+			{
+				const int removeX = leftToRight ? x - 1 : x + 2 * radius.x + 1;
+				const int addX = leftToRight ? x + 2 * radius.x : x;
+				for( int wy = y; wy <= y + 2 * radius.y; ++wy )
+				{
+					histogram.remove( ranks[wy * inputWidth + removeX] );
+					histogram.add( ranks[wy * inputWidth + addX] );
+				}
+			}
+			result[y * tileSize + x] = sortedValues[histogram.nth( k )];
+		}
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// RankFilter
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( RankFilter );
 
 size_t RankFilter::g_firstPlugIndex = 0;
@@ -63,10 +279,15 @@ RankFilter::RankFilter( const std::string &name, Mode mode )
 	addChild( new BoolPlug( "expandDataWindow" ) );
 	addChild( new StringPlug( "masterChannel" ) );
 	addChild( new V2iVectorDataPlug( "__pixelOffsets", Plug::Out, new V2iVectorData ) );
+	addChild( new ImagePlug( "__horizontalPass", Plug::Out ) );
 
 	outPlug()->formatPlug()->setInput( inPlug()->formatPlug() );
 	outPlug()->metadataPlug()->setInput( inPlug()->metadataPlug() );
 	outPlug()->channelNamesPlug()->setInput( inPlug()->channelNamesPlug() );
+
+	horizontalPassPlug()->formatPlug()->setInput( inPlug()->formatPlug() );
+	horizontalPassPlug()->metadataPlug()->setInput( inPlug()->metadataPlug() );
+	horizontalPassPlug()->channelNamesPlug()->setInput( inPlug()->channelNamesPlug() );
 	m_mode = mode;
 }
 
@@ -124,6 +345,21 @@ const Gaffer::V2iVectorDataPlug *RankFilter::pixelOffsetsPlug() const
 	return getChild<V2iVectorDataPlug>( g_firstPlugIndex + 4 );
 }
 
+ImagePlug *RankFilter::horizontalPassPlug()
+{
+	return getChild<ImagePlug>( g_firstPlugIndex + 5 );
+}
+
+const ImagePlug *RankFilter::horizontalPassPlug() const
+{
+	return getChild<ImagePlug>( g_firstPlugIndex + 5 );
+}
+
+bool RankFilter::separable() const
+{
+	return m_mode != MedianRank && masterChannelPlug()->getValue().empty();
+}
+
 
 void RankFilter::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
@@ -136,6 +372,7 @@ void RankFilter::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 	)
 	{
 		outputs.push_back( outPlug()->dataWindowPlug() );
+		outputs.push_back( horizontalPassPlug()->dataWindowPlug() );
 	}
 
 	if(
@@ -147,6 +384,14 @@ void RankFilter::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 	{
 		outputs.push_back( pixelOffsetsPlug() );
 		outputs.push_back( outPlug()->channelDataPlug() );
+		outputs.push_back( horizontalPassPlug()->channelDataPlug() );
+	}
+	else if(
+		input == horizontalPassPlug()->channelDataPlug() ||
+		input == horizontalPassPlug()->dataWindowPlug()
+	)
+	{
+		outputs.push_back( outPlug()->channelDataPlug() );
 	}
 }
 
@@ -174,8 +419,10 @@ Imath::Box2i RankFilter::computeDataWindow( const Gaffer::Context *context, cons
 	Box2i dataWindow = inPlug()->dataWindowPlug()->getValue();
 	if( !BufferAlgo::empty( dataWindow ) )
 	{
-		dataWindow.min -= radius;
-		dataWindow.max += radius;
+		// The horizontal pass only expands horizontally.
+		const V2i expansion = parent == horizontalPassPlug() ? V2i( radius.x, 0 ) : radius;
+		dataWindow.min -= expansion;
+		dataWindow.max += expansion;
 	}
 	return dataWindow;
 }
@@ -252,7 +499,7 @@ void RankFilter::compute( Gaffer::ValuePlug *output, const Gaffer::Context *cont
 						// To compute the pixel offset to the rank in this channel,
 						// we first compute the rank as usual
 						std::copy (pixels.begin(), pixels.end(), sortPixels.begin());
-						nth_element( sortPixels.begin(), resultIt, sortPixels.end() );
+						nth_element( sortPixels.begin(), resultIt, sortPixels.end(), lessWithNaNsLast );
 						break;
 					case ErodeRank:
 						resultIt = min_element( pixels.begin(), pixels.end() );
@@ -272,8 +519,10 @@ void RankFilter::compute( Gaffer::ValuePlug *output, const Gaffer::Context *cont
 				{
 					for( o.x = -radius.x; o.x <= radius.x; ++o.x )
 					{
-						// If we've found a pixel which matches the rank value
-						if( *pixelsIt++ == *resultIt )
+						// If we've found a pixel which matches the rank value.
+						// We can't use `==` because it is false for NaNs.
+						const float v = *pixelsIt++;
+						if( !lessWithNaNsLast( v, *resultIt ) && !lessWithNaNsLast( *resultIt, v ) )
 						{
 							int absX = abs( o.x );
 							int absY = abs( o.y );
@@ -326,6 +575,23 @@ void RankFilter::hashChannelData( const GafferImage::ImagePlug *parent, const Ga
 
 	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+
+	if( separable() )
+	{
+		const bool horizontal = parent == horizontalPassPlug();
+		const V2i passRadius = horizontal ? V2i( radius.x, 0 ) : V2i( 0, radius.y );
+		Sampler sampler(
+			horizontal ? inPlug() : horizontalPassPlug(),
+			context->get<std::string>( ImagePlug::channelNameContextName ),
+			Box2i( tileBound.min - passRadius, tileBound.max + passRadius ),
+			(Sampler::BoundingMode)boundingModePlug()->getValue()
+		);
+		sampler.hash( h );
+		h.append( passRadius );
+		h.append( tileOrigin );
+		return;
+	}
+
 	const Box2i inputBound( tileBound.min - radius, tileBound.max + radius );
 
 	Sampler sampler(
@@ -358,6 +624,62 @@ IECore::ConstFloatVectorDataPtr RankFilter::computeChannelData( const std::strin
 	}
 
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+
+	if( separable() )
+	{
+		// Erode and Dilate are separable, so we process them as a horizontal
+		// pass onto horizontalPassPlug(), followed by a vertical pass from there
+		// to the output. Each pass uses the van Herk/Gil-Werman algorithm, so
+		// the cost per pixel is independent of the radius.
+		const bool horizontal = parent == horizontalPassPlug();
+		const int passRadius = horizontal ? radius.x : radius.y;
+		const int tileSize = ImagePlug::tileSize();
+
+		Sampler sampler(
+			horizontal ? inPlug() : horizontalPassPlug(),
+			channelName,
+			Box2i(
+				tileBound.min - ( horizontal ? V2i( passRadius, 0 ) : V2i( 0, passRadius ) ),
+				tileBound.max + ( horizontal ? V2i( passRadius, 0 ) : V2i( 0, passRadius ) )
+			),
+			(Sampler::BoundingMode)boundingModePlug()->getValue()
+		);
+
+		FloatVectorDataPtr resultData = new FloatVectorData;
+		vector<float> &result = resultData->writable();
+		result.resize( tileSize * tileSize );
+
+		vector<float> line( tileSize + 2 * passRadius );
+		vector<float> prefix, suffix;
+		for( int i = 0; i < tileSize; ++i )
+		{
+			IECore::Canceller::check( context->canceller() );
+
+			// When horizontal, `i` indexes rows and we sample along x.
+			// When vertical, `i` indexes columns and we sample along y.
+			for( int j = -passRadius, e = tileSize + passRadius; j < e; ++j )
+			{
+				line[j + passRadius] = horizontal ?
+					sampler.sample( tileBound.min.x + j, tileBound.min.y + i ) :
+					sampler.sample( tileBound.min.x + i, tileBound.min.y + j )
+				;
+			}
+
+			float *out = horizontal ? &result[i * tileSize] : &result[i];
+			const int outStride = horizontal ? 1 : tileSize;
+			if( m_mode == ErodeRank )
+			{
+				slidingExtreme( line, passRadius, tileSize, prefix, suffix, out, outStride, Min() );
+			}
+			else
+			{
+				slidingExtreme( line, passRadius, tileSize, prefix, suffix, out, outStride, Max() );
+			}
+		}
+
+		return resultData;
+	}
+
 	const Box2i inputBound( tileBound.min - radius, tileBound.max + radius );
 
 	Sampler sampler(
@@ -397,6 +719,15 @@ IECore::ConstFloatVectorDataPtr RankFilter::computeChannelData( const std::strin
 		return resultData;
 	}
 
+	// Erode and Dilate are handled above, so only Median remains.
+	if( ( inputBound.size().x * inputBound.size().y ) <= g_maxSlidingMedianPixels )
+	{
+		medianTile( sampler, tileBound, radius, context, result );
+		return resultData;
+	}
+
+	// The input region is too large to rank in one go, so we fall
+	// back to finding the median of each pixel independently.
 	vector<float> pixels( ( 1 + 2 * radius.x ) * ( 1 + 2 * radius.y ) );
 	vector<float>::iterator resultIt = pixels.begin() + pixels.size() / 2;
 
@@ -416,18 +747,7 @@ IECore::ConstFloatVectorDataPtr RankFilter::computeChannelData( const std::strin
 					*pixelsIt++ = sampler.sample( p.x + o.x, p.y + o.y );
 				}
 			}
-			switch( m_mode )
-			{
-				case MedianRank:
-					nth_element( pixels.begin(), resultIt, pixels.end() );
-					break;
-				case ErodeRank:
-					resultIt = min_element( pixels.begin(), pixels.end() );
-					break;
-				case DilateRank:
-					resultIt = max_element( pixels.begin(), pixels.end() );
-					break;
-			}
+			nth_element( pixels.begin(), resultIt, pixels.end(), lessWithNaNsLast );
 			result.push_back( *resultIt );
 		}
 	}
@@ -185,13 +185,8 @@ const OIIO::Filter2D *filterAndScale( const std::string &name, V2f ratio, V2f &i
 }
 
 // Precomputes all the filter weights for a whole row or column of a tile. For separable
-// filters these weights can then be reused across all rows/columns in the same tile.
-/// \todo The weights computed for a particular tile could also be reused for all
-/// tiles in the same tile column or row. We could achieve this by outputting
-/// the weights on an internal plug, and using Gaffer's caching to ensure they are
-/// only computed once and then reused. At the time of writing, profiles indicate that
-/// accessing pixels via the Sampler is the main bottleneck, but once that is optimised
-/// perhaps cached filter weights could have a benefit.
+// filters these weights can then be reused across all rows/columns in the same tile,
+// and via the weights plugs, across all tiles in the same tile column or row.
 void filterWeights( const OIIO::Filter2D *filter, const float inputFilterScale, const int filterRadius, const int x, const float ratio, const float offset, Passes pass, std::vector<float> &weights )
 {
 	weights.reserve( ( 2 * filterRadius + 1 ) * ImagePlug::tileSize() );
@@ -216,6 +211,25 @@ void filterWeights( const OIIO::Filter2D *filter, const float inputFilterScale,
 	}
 }
 
+// Sums the weights for each output pixel, in the same order in which they
+// are applied by the filter loops, so that normalisation is exact.
+void totalWeights( const std::vector<float> &weights, const int filterRadius, std::vector<float> &totals )
+{
+	const int filterWidth = 2 * filterRadius + 1;
+	totals.resize( weights.size() / filterWidth );
+
+	std::vector<float>::const_iterator wIt = weights.begin();
+	for( std::vector<float>::iterator it = totals.begin(), eIt = totals.end(); it != eIt; ++it )
+	{
+		float totalW = 0.0f;
+		for( int i = 0; i < filterWidth; ++i )
+		{
+			totalW += *wIt++;
+		}
+		*it = totalW;
+	}
+}
+
 Box2f transform( const Box2f &b, const M33f &m )
 {
 	if( b.isEmpty() )
@@ -231,6 +245,60 @@ Box2f transform( const Box2f &b, const M33f &m )
 	return r;
 }
 
+int mipLevel( const Context *context )
+{
+	return context->get<int>( ImagePlug::mipLevelContextName, 0 );
+}
+
+// Returns the matrix, adjusted to suit the mip level being computed.
+// The plug itself is always evaluated at full resolution, so that
+// nodes like Resize can compute it from full resolution formats.
+M33f resampleMatrix( const Resample *resample, const Context *context )
+{
+	M33f result;
+	{
+		ImagePlug::GlobalScope c( context );
+		c.remove( ImagePlug::mipLevelContextName );
+		result = resample->matrixPlug()->getValue();
+	}
+
+	if( const int level = mipLevel( context ) )
+	{
+		// Pixels are `2^level` times larger in both the input and
+		// output, so the scale is unchanged but the translation is not.
+		const float factor = 1 << level;
+		result[2][0] /= factor;
+		result[2][1] /= factor;
+	}
+
+	return result;
+}
+
+// As for `filterAndScale()`, but taking into account the filter scale
+// and the mip level being computed.
+const OIIO::Filter2D *resampleFilter( const Resample *resample, const V2f &ratio, const Context *context, V2f &inputFilterScale )
+{
+	const OIIO::Filter2D *filter = filterAndScale( resample->filterPlug()->getValue(), ratio, inputFilterScale );
+	{
+		Context::EditableScope c( context );
+		c.remove( ImagePlug::mipLevelContextName );
+		inputFilterScale *= resample->filterScalePlug()->getValue();
+	}
+
+	if( const int level = mipLevel( context ) )
+	{
+		// The input has already been box filtered by the reduction to
+		// this mip level, so the filter need only cover the remainder.
+		const float factor = 1 << level;
+		inputFilterScale = V2f(
+			std::max( 1.0f, inputFilterScale.x / factor ),
+			std::max( 1.0f, inputFilterScale.y / factor )
+		);
+	}
+
+	return filter;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -252,6 +320,8 @@ Resample::Resample( const std::string &name )
 	addChild( new BoolPlug( "expandDataWindow" ) );
 	addChild( new IntPlug( "debug", Plug::In, Off, Off, SinglePass ) );
 	addChild( new ImagePlug( "__horizontalPass", Plug::Out ) );
+	addChild( new FloatVectorDataPlug( "__horizontalWeights", Plug::Out, new FloatVectorData ) );
+	addChild( new FloatVectorDataPlug( "__verticalWeights", Plug::Out, new FloatVectorData ) );
 
 	// We don't ever want to change these, so we make pass-through connections.
 
@@ -339,6 +409,31 @@ const ImagePlug *Resample::horizontalPassPlug() const
 	return getChild<ImagePlug>( g_firstPlugIndex + 6 );
 }
 
+Gaffer::FloatVectorDataPlug *Resample::horizontalWeightsPlug()
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 7 );
+}
+
+const Gaffer::FloatVectorDataPlug *Resample::horizontalWeightsPlug() const
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 7 );
+}
+
+Gaffer::FloatVectorDataPlug *Resample::verticalWeightsPlug()
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 8 );
+}
+
+const Gaffer::FloatVectorDataPlug *Resample::verticalWeightsPlug() const
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 8 );
+}
+
+bool Resample::supportsMipLevels() const
+{
+	return true;
+}
+
 void Resample::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -369,6 +464,73 @@ void Resample::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outpu
 		outputs.push_back( outPlug()->channelDataPlug() );
 		outputs.push_back( horizontalPassPlug()->channelDataPlug() );
 	}
+
+	if(
+		input == matrixPlug() ||
+		input == filterPlug() ||
+		input->parent<V2fPlug>() == filterScalePlug()
+	)
+	{
+		outputs.push_back( horizontalWeightsPlug() );
+		outputs.push_back( verticalWeightsPlug() );
+	}
+
+	if( input == horizontalWeightsPlug() || input == verticalWeightsPlug() )
+	{
+		outputs.push_back( outPlug()->channelDataPlug() );
+		outputs.push_back( horizontalPassPlug()->channelDataPlug() );
+	}
+}
+
+void Resample::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	ImageProcessor::hash( output, context, h );
+
+	if( output == horizontalWeightsPlug() || output == verticalWeightsPlug() )
+	{
+		V2f ratio, offset;
+		ratioAndOffset( resampleMatrix( this, context ), ratio, offset );
+
+		V2f inputFilterScale;
+		const OIIO::Filter2D *filter = resampleFilter( this, ratio, context, inputFilterScale );
+
+		// The weights are shared by all tiles in the same column (for
+		// the horizontal pass) or row (for the vertical pass), so we
+		// only hash the relevant component of the tile origin.
+		const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+		const int axis = output == horizontalWeightsPlug() ? 0 : 1;
+
+		h.append( filter->name().str() );
+		h.append( inputFilterScale[axis] );
+		h.append( ratio[axis] );
+		h.append( offset[axis] );
+		h.append( tileOrigin[axis] );
+	}
+}
+
+void Resample::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == horizontalWeightsPlug() || output == verticalWeightsPlug() )
+	{
+		V2f ratio, offset;
+		ratioAndOffset( resampleMatrix( this, context ), ratio, offset );
+
+		V2f inputFilterScale;
+		const OIIO::Filter2D *filter = resampleFilter( this, ratio, context, inputFilterScale );
+
+		const V2i filterRadius = inputFilterRadius( filter, inputFilterScale );
+		const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+		const Passes pass = output == horizontalWeightsPlug() ? Horizontal : Vertical;
+		const int axis = pass == Horizontal ? 0 : 1;
+
+		FloatVectorDataPtr weightsData = new FloatVectorData;
+		filterWeights( filter, inputFilterScale[axis], filterRadius[axis], tileOrigin[axis], ratio[axis], offset[axis], pass, weightsData->writable() );
+
+		static_cast<FloatVectorDataPlug *>( output )->setValue( weightsData );
+		return;
+	}
+
+	ImageProcessor::compute( output, context );
 }
 
 void Resample::hashDataWindow( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const
@@ -376,11 +538,15 @@ void Resample::hashDataWindow( const GafferImage::ImagePlug *parent, const Gaffe
 	ImageProcessor::hashDataWindow( parent, context, h );
 
 	inPlug()->dataWindowPlug()->hash( h );
-	matrixPlug()->hash( h );
 	expandDataWindowPlug()->hash( h );
 	filterPlug()->hash( h );
-	filterScalePlug()->hash( h );
 	debugPlug()->hash( h );
+
+	h.append( mipLevel( context ) );
+	Context::EditableScope fullResolutionScope( context );
+	fullResolutionScope.remove( ImagePlug::mipLevelContextName );
+	matrixPlug()->hash( h );
+	filterScalePlug()->hash( h );
 }
 
 Imath::Box2i Resample::computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const
@@ -394,7 +560,7 @@ Imath::Box2i Resample::computeDataWindow( const Gaffer::Context *context, const
 	// Figure out our data window as a Box2f with fractional
 	// pixel values.
 
-	const M33f matrix = matrixPlug()->getValue();
+	const M33f matrix = resampleMatrix( this, context );
 	Box2f dstDataWindow = transform( Box2f( srcDataWindow.min, srcDataWindow.max ), matrix );
 
 	if( expandDataWindowPlug()->getValue() )
@@ -403,8 +569,7 @@ Imath::Box2i Resample::computeDataWindow( const Gaffer::Context *context, const
 		ratioAndOffset( matrix, ratio, offset );
 
 		V2f inputFilterScale;
-		const OIIO::Filter2D *filter = filterAndScale( filterPlug()->getValue(), ratio, inputFilterScale );
-		inputFilterScale *= filterScalePlug()->getValue();
+		const OIIO::Filter2D *filter = resampleFilter( this, ratio, context, inputFilterScale );
 
 		const V2f filterRadius = V2f( filter->width(), filter->height() ) * inputFilterScale * 0.5f;
 
@@ -455,14 +620,10 @@ void Resample::hashChannelData( const GafferImage::ImagePlug *parent, const Gaff
 	ImageProcessor::hashChannelData( parent, context, h );
 
 	V2f ratio, offset;
-	{
-		ImagePlug::GlobalScope c( context );
-		ratioAndOffset( matrixPlug()->getValue(), ratio, offset );
-	}
+	ratioAndOffset( resampleMatrix( this, context ), ratio, offset );
 
 	V2f inputFilterScale;
-	const OIIO::Filter2D *filter = filterAndScale( filterPlug()->getValue(), ratio, inputFilterScale );
-	inputFilterScale *= filterScalePlug()->getValue();
+	const OIIO::Filter2D *filter = resampleFilter( this, ratio, context, inputFilterScale );
 
 	filterPlug()->hash( h );
 
@@ -498,21 +659,18 @@ void Resample::hashChannelData( const GafferImage::ImagePlug *parent, const Gaff
 IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	V2f ratio, offset;
-	{
-		ImagePlug::GlobalScope c( context );
-		ratioAndOffset( matrixPlug()->getValue(), ratio, offset );
-	}
+	ratioAndOffset( resampleMatrix( this, context ), ratio, offset );
 
 	V2f inputFilterScale;
-	const OIIO::Filter2D *filter = filterAndScale( filterPlug()->getValue(), ratio, inputFilterScale );
-	inputFilterScale *= filterScalePlug()->getValue();
+	const OIIO::Filter2D *filter = resampleFilter( this, ratio, context, inputFilterScale );
 
 	const unsigned passes = requiredPasses( this, parent, filter );
+	const Box2i region = inputRegion( tileOrigin, passes, ratio, offset, filter, inputFilterScale );
 
 	Sampler sampler(
 		passes == Vertical ? horizontalPassPlug() : inPlug(),
 		channelName,
-		inputRegion( tileOrigin, passes, ratio, offset, filter, inputFilterScale ),
+		region,
 		(Sampler::BoundingMode)boundingModePlug()->getValue()
 	);
 
@@ -614,29 +772,50 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 		// debug mode causes this pass to be output directly for inspection.
 
 		// Pixels in the same column share the same filter weights, so
-		// we precompute the weights now to avoid repeating work later.
-		std::vector<float> weights;
-		filterWeights( filter, inputFilterScale.x, filterRadius.x, tileBound.min.x, ratio.x, offset.x, Horizontal, weights );
+		// we get them from horizontalWeightsPlug(), where they are cached
+		// and reused by all tiles in the same tile column.
+		ConstFloatVectorDataPtr weightsData = horizontalWeightsPlug()->getValue();
+		const std::vector<float> &weights = weightsData->readable();
+		std::vector<float> totals;
+		totalWeights( weights, filterRadius.x, totals );
+
+		// The index into the row buffer of the first input pixel
+		// for each output column.
+		std::vector<int> inputIndices;
+		inputIndices.reserve( ImagePlug::tileSize() );
 
 		V2i oP; // output pixel position
 		float iX; // input pixel x coordinate (floating point)
 		int iXI; // input pixel position (floored to int)
 
+		for( oP.x = tileBound.min.x; oP.x < tileBound.max.x; ++oP.x )
+		{
+			iX = ( oP.x + 0.5 ) / ratio.x + offset.x;
+			OIIO::floorfrac( iX, &iXI );
+			inputIndices.push_back( iXI - filterRadius.x - region.min.x );
+		}
+
+		// Each input row is read into a contiguous buffer before
+		// filtering, so that the inner loop below accesses memory
+		// sequentially rather than going through the Sampler.
+		std::vector<float> row( region.size().x );
+		const int filterWidth = 2 * filterRadius.x + 1;
+
 		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
 		{
 			Canceller::check( context->canceller() );
 
-			std::vector<float>::const_iterator wIt = weights.begin();
-			for( oP.x = tileBound.min.x; oP.x < tileBound.max.x; ++oP.x )
+			for( int x = region.min.x; x < region.max.x; ++x )
 			{
+				row[x - region.min.x] = sampler.sample( x, oP.y );
+			}
 
-				iX = ( oP.x + 0.5 ) / ratio.x + offset.x;
-				OIIO::floorfrac( iX, &iXI );
-
-				int fX; // relative filter position
+			std::vector<float>::const_iterator wIt = weights.begin();
+			for( int i = 0, e = ImagePlug::tileSize(); i < e; ++i )
+			{
+				const float *r = &row[inputIndices[i]];
 				float v = 0.0f;
-				float totalW = 0.0f;
-				for( fX = -filterRadius.x; fX<= filterRadius.x; ++fX )
+				for( int fX = 0; fX < filterWidth; ++fX )
 				{
 					const float w = *wIt++;
 					if( w == 0.0f )
@@ -644,13 +823,12 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 						continue;
 					}
 
-					v += w * sampler.sample( iXI + fX, oP.y );
-					totalW += w;
+					v += w * r[fX];
 				}
 
-				if( totalW != 0.0f )
+				if( totals[i] != 0.0f )
 				{
-					*pIt = v / totalW;
+					*pIt = v / totals[i];
 				}
 
 				++pIt;
@@ -659,15 +837,36 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 	}
 	else if( passes == Vertical )
 	{
+		const int tileSize = ImagePlug::tileSize();
+
+		// Pixels in the same row share the same filter weights, so
+		// we get them from verticalWeightsPlug(), where they are cached
+		// and reused by all tiles in the same tile row.
+		ConstFloatVectorDataPtr weightsData = verticalWeightsPlug()->getValue();
+		const std::vector<float> &weights = weightsData->readable();
+		std::vector<float> totals;
+		totalWeights( weights, filterRadius.y, totals );
+
+		// Read all the input rows into a contiguous buffer, so that
+		// we can accumulate each output row from whole input rows at
+		// a time, with sequential memory access in the inner loop.
+		std::vector<float> input( tileSize * region.size().y );
+		std::vector<float>::iterator inputIt = input.begin();
+		for( int y = region.min.y; y < region.max.y; ++y )
+		{
+			Canceller::check( context->canceller() );
+			for( int x = tileBound.min.x; x < tileBound.max.x; ++x )
+			{
+				*inputIt++ = sampler.sample( x, y );
+			}
+		}
+
 		V2i oP; // output pixel position
 		float iY; // input pixel position (floating point)
 		int iYI; // input pixel position (floored to int)
 
-		// Pixels in the same row share the same filter weights, so
-		// we precompute the weights now to avoid repeating work later.
-		std::vector<float> weights;
-		filterWeights( filter, inputFilterScale.y, filterRadius.y, tileBound.min.y, ratio.y, offset.y, Vertical, weights );
-
+		std::vector<float> v( tileSize );
+		std::vector<float>::const_iterator wIt = weights.begin();
 		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
 		{
 			Canceller::check( context->canceller() );
@@ -675,31 +874,32 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 			iY = ( oP.y + 0.5 ) / ratio.y + offset.y;
 			OIIO::floorfrac( iY, &iYI );
 
-			for( oP.x = tileBound.min.x; oP.x < tileBound.max.x; ++oP.x )
+			std::fill( v.begin(), v.end(), 0.0f );
+			for( int fY = -filterRadius.y; fY <= filterRadius.y; ++fY )
 			{
-				int fY; // relative filter position
-				float v = 0.0f;
-				float totalW = 0.0f;
-				std::vector<float>::const_iterator wIt = weights.begin() + ( oP.y - tileBound.min.y ) * ( filterRadius.y * 2 + 1);
-				for( fY = -filterRadius.y; fY<= filterRadius.y; ++fY )
+				const float w = *wIt++;
+				if( w == 0.0f )
 				{
-					const float w = *wIt++;
-					if( w == 0.0f )
-					{
-						continue;
-					}
-
-					v += w * sampler.sample( oP.x, iYI + fY );
-					totalW += w;
+					continue;
 				}
 
-				if( totalW != 0.0f )
+				const float *r = &input[( iYI + fY - region.min.y ) * tileSize];
+				for( int x = 0; x < tileSize; ++x )
 				{
-					*pIt = v / totalW;
+					v[x] += w * r[x];
 				}
+			}
 
-				++pIt;
+			const float totalW = totals[oP.y - tileBound.min.y];
+			if( totalW != 0.0f )
+			{
+				for( int x = 0; x < tileSize; ++x )
+				{
+					pIt[x] = v[x] / totalW;
+				}
 			}
+
+			pIt += tileSize;
 		}
 	}
 
@@ -130,6 +130,11 @@ const ValuePlug *Shuffle::channelsPlug() const
 	return getChild<ValuePlug>( g_firstPlugIndex );
 }
 
+bool Shuffle::supportsMipLevels() const
+{
+	return true;
+}
+
 void Shuffle::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -50,6 +50,7 @@
 
 #include FT_FREETYPE_H
 
+#include <cstring>
 #include <memory>
 
 using namespace std;
@@ -153,6 +154,118 @@ FT_Matrix transform( const M33f &transform, FT_Vector &delta )
 	return matrix;
 }
 
+// Rendering glyphs with FreeType is relatively expensive, and the same
+// glyphs are typically needed by many tiles, many Text nodes and many
+// frames. So we cache the rendered bitmaps in a cache shared by all
+// threads. A whole pixel translation just offsets the bitmap, so
+// only the fractional part of the translation is included in the key.
+
+struct Glyph
+{
+	// Coverage values, with rows ordered from top to bottom.
+	vector<unsigned char> buffer;
+	int width;
+	int rows;
+	int left;
+	int top;
+	FT_Vector advance;
+	bool valid;
+};
+
+typedef std::shared_ptr<const Glyph> ConstGlyphPtr;
+
+struct GlyphCacheGetterKey
+{
+
+	GlyphCacheGetterKey()
+		:	font( nullptr )
+	{
+	}
+
+	GlyphCacheGetterKey( const string &font, const V2i &size, char character, const M33f &characterTransform )
+		:	font( &font ), size( size ), character( character )
+	{
+		matrix = transform( characterTransform, delta );
+		offset = V2i( delta.x >> 6, delta.y >> 6 );
+		delta.x &= 63;
+		delta.y &= 63;
+
+		hash.append( font );
+		hash.append( size );
+		hash.append( character );
+		hash.append( (int64_t)matrix.xx );
+		hash.append( (int64_t)matrix.xy );
+		hash.append( (int64_t)matrix.yx );
+		hash.append( (int64_t)matrix.yy );
+		hash.append( (int64_t)delta.x );
+		hash.append( (int64_t)delta.y );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	// Returns the bound of the glyph's bitmap in pixel space.
+	Box2i bound( const Glyph *glyph ) const
+	{
+		return Box2i(
+			offset + V2i( glyph->left, glyph->top - glyph->rows ),
+			offset + V2i( glyph->left + glyph->width, glyph->top )
+		);
+	}
+
+	const string *font;
+	V2i size;
+	char character;
+	FT_Matrix matrix;
+	FT_Vector delta;
+	V2i offset;
+	IECore::MurmurHash hash;
+
+};
+
+ConstGlyphPtr glyphGetter( const GlyphCacheGetterKey &key, size_t &cost )
+{
+	FacePtr face = ::face( *key.font, key.size );
+
+	FT_Matrix matrix = key.matrix;
+	FT_Vector delta = key.delta;
+	FT_Set_Transform( face.get(), &matrix, &delta );
+	FT_Error error = FT_Load_Char( face.get(), key.character, FT_LOAD_RENDER );
+	FT_Set_Transform( face.get(), nullptr, nullptr );
+
+	std::shared_ptr<Glyph> glyph( new Glyph );
+	glyph->valid = !error;
+	if( error )
+	{
+		glyph->width = glyph->rows = glyph->left = glyph->top = 0;
+		glyph->advance.x = glyph->advance.y = 0;
+		cost = sizeof( Glyph );
+		return glyph;
+	}
+
+	const FT_GlyphSlot slot = face->glyph;
+	const FT_Bitmap &bitmap = slot->bitmap;
+	glyph->width = bitmap.width;
+	glyph->rows = bitmap.rows;
+	glyph->left = slot->bitmap_left;
+	glyph->top = slot->bitmap_top;
+	glyph->advance = slot->advance;
+
+	glyph->buffer.resize( glyph->width * glyph->rows );
+	for( int y = 0; y < glyph->rows; ++y )
+	{
+		memcpy( glyph->buffer.data() + y * glyph->width, bitmap.buffer + y * bitmap.pitch, glyph->width );
+	}
+
+	cost = sizeof( Glyph ) + glyph->buffer.size();
+	return glyph;
+}
+
+typedef LRUCache<IECore::MurmurHash, ConstGlyphPtr, LRUCachePolicy::Parallel, GlyphCacheGetterKey> GlyphCache;
+GlyphCache g_glyphCache( glyphGetter, 64 * 1024 * 1024 );
+
 int width( const string &word, FT_FaceRec *face )
 {
 	int result = 0;
@@ -474,8 +587,6 @@ IECore::ConstCompoundObjectPtr Text::computeLayout( const Gaffer::Context *conte
 		yOffset = (float)(area.min.y - (pen.y + face->size->metrics.descender) ) / (64.0f * 2.0f);
 	}
 
-	FT_GlyphSlot slot = face->glyph;
-
 	for( vector<Line>::const_iterator lIt = lines.begin(), leIt = lines.end(); lIt != leIt; ++lIt )
 	{
 		float xOffset = 0;
@@ -497,28 +608,19 @@ IECore::ConstCompoundObjectPtr Text::computeLayout( const Gaffer::Context *conte
 
 			for( const char *c = wIt->text.c_str(); *c; ++c )
 			{
-				FT_Vector delta;
-				FT_Matrix matrix = ::transform( characterTransform, delta );
-				FT_Set_Transform( face.get(), &matrix, &delta );
-
-				FT_Error e = FT_Load_Char( face.get(), *c, FT_LOAD_RENDER );
-				if( e )
+				const GlyphCacheGetterKey glyphKey( font, size, *c, characterTransform );
+				ConstGlyphPtr glyph = g_glyphCache.get( glyphKey );
+				if( !glyph->valid )
 				{
 					continue;
 				}
 
-				const FT_Bitmap &bitmap = slot->bitmap;
-				const Box2i bound(
-					V2i( slot->bitmap_left, slot->bitmap_top - bitmap.rows ),
-					V2i( slot->bitmap_left + bitmap.width, slot->bitmap_top )
-				);
-
 				characters->writable().push_back( *c );
 				transforms->writable().push_back( characterTransform );
-				bounds->writable().push_back( bound );
+				bounds->writable().push_back( glyphKey.bound( glyph.get() ) );
 
-				characterTransform[2][0] += (float)slot->advance.x / 64.0f;
-				characterTransform[2][1] += (float)slot->advance.y / 64.0f;
+				characterTransform[2][0] += (float)glyph->advance.x / 64.0f;
+				characterTransform[2][1] += (float)glyph->advance.y / 64.0f;
 			}
 		}
 	}
@@ -588,8 +690,8 @@ IECore::ConstFloatVectorDataPtr Text::computeShapeChannelData(  const Imath::V2i
 	const vector<M33f> &transforms = layout->member<M33fVectorData>( "transforms" )->readable();
 	const vector<Box2i> &bounds = layout->member<Box2iVectorData>( "bounds" )->readable();
 
-	FacePtr face = ::face( layout->member<StringData>( "font" )->readable(), layout->member<V2iData>( "size" )->readable() );
-	FT_GlyphSlot slot = face->glyph;
+	const string &font = layout->member<StringData>( "font" )->readable();
+	const V2i &size = layout->member<V2iData>( "size" )->readable();
 
 	FloatVectorDataPtr resultData = new FloatVectorData();
 	vector<float> &result = resultData->writable();
@@ -606,22 +708,18 @@ IECore::ConstFloatVectorDataPtr Text::computeShapeChannelData(  const Imath::V2i
 			continue;
 		}
 
-		FT_Vector delta;
-		FT_Matrix matrix = transform( transforms[i], delta );
-		FT_Set_Transform( face.get(), &matrix, &delta );
-
-		FT_Error error = FT_Load_Char( face.get(), characters[i], FT_LOAD_RENDER );
-		if( error )
+		// The glyph will almost always be in the cache already,
+		// having been rendered during layout.
+		ConstGlyphPtr glyph = g_glyphCache.get( GlyphCacheGetterKey( font, size, characters[i], transforms[i] ) );
+		if( !glyph->valid )
 		{
 			continue;
 		}
 
-		const FT_Bitmap &bitmap = slot->bitmap;
-
 		V2i p;
 		for( p.y = validBound.min.y; p.y < validBound.max.y; ++p.y )
 		{
-			const unsigned char *src = bitmap.buffer + ( bitmapBound.max.y - 1 - p.y ) * bitmap.pitch + validBound.min.x - bitmapBound.min.x;
+			const unsigned char *src = glyph->buffer.data() + ( bitmapBound.max.y - 1 - p.y ) * glyph->width + validBound.min.x - bitmapBound.min.x;
 			vector<float>::iterator dst = result.begin() + ( p.y - tileBound.min.y ) * ImagePlug::tileSize() + validBound.min.x - tileBound.min.x;
 			for( p.x = validBound.min.x; p.x < validBound.max.x; ++p.x )
 			{
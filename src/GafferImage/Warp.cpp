@@ -56,6 +56,45 @@ namespace
 	static IECore::InternedString g_tileInputBoundName( "tileInputBound"  );
 	static IECore::InternedString g_pixelInputPositionsName( "pixelInputPositions"  );
 	static IECore::InternedString g_pixelInputDerivativesName( "pixelInputDerivatives"  );
+	static IECore::InternedString g_pixelFootprintsName( "pixelFootprints"  );
+	static IECore::InternedString g_pixelFilterWeightsName( "pixelFilterWeights"  );
+
+	// For each pixel, the footprint stores the origin and size of the region of input
+	// pixels covered by the filter, and the offset of its filter weights.
+	const int g_footprintSize = 5;
+
+	// Computes the footprint and separable filter weights used by `FilterAlgo::sampleBox()`,
+	// so that they can be computed once per tile and shared by all channels, rather than
+	// evaluating the filter for every pixel of every channel. The arithmetic matches
+	// `sampleBox()` exactly, so results are identical.
+	void appendFootprint( const V2f &p, float dx, float dy, const OIIO::Filter2D *filter, vector<int> &footprints, vector<float> &weights )
+	{
+		const float xscale = 1.0f / dx;
+		const float yscale = 1.0f / dy;
+
+		const Box2f bounds = FilterAlgo::filterSupport( p, dx, dy, filter->width() );
+		const Box2i pixelBounds(
+			V2i( (int)ceilf( bounds.min.x - 0.5 ), (int)ceilf( bounds.min.y - 0.5 ) ),
+			V2i( (int)floorf( bounds.max.x - 0.5 ) + 1, (int)floorf( bounds.max.y - 0.5 ) + 1 ) );
+
+		const int width = std::max( 0, pixelBounds.max.x - pixelBounds.min.x );
+		const int height = std::max( 0, pixelBounds.max.y - pixelBounds.min.y );
+
+		footprints.push_back( pixelBounds.min.x );
+		footprints.push_back( pixelBounds.min.y );
+		footprints.push_back( width );
+		footprints.push_back( height );
+		footprints.push_back( (int)weights.size() );
+
+		for( int x = pixelBounds.min.x; x < pixelBounds.max.x; ++x )
+		{
+			weights.push_back( filter->xfilt( ( x + 0.5f - p.x ) * xscale ) );
+		}
+		for( int y = pixelBounds.min.y; y < pixelBounds.max.y; ++y )
+		{
+			weights.push_back( filter->yfilt( ( y + 0.5f - p.y ) * yscale ) );
+		}
+	}
 
 	const CompoundObject *sampleRegionsEmptyTile()
 	{
@@ -584,6 +623,30 @@ void Warp::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context )
 		sampleRegions->members()[ g_tileInputBoundName ] = new Box2iData( inputPixelBound );
 		sampleRegions->members()[ g_pixelInputPositionsName ] = pixelInputPositionsData;
 		sampleRegions->members()[ g_pixelInputDerivativesName ] = pixelInputDerivativesData;
+
+		if( filter->separable() )
+		{
+			IntVectorDataPtr pixelFootprintsData = new IntVectorData();
+			std::vector<int> &pixelFootprints = pixelFootprintsData->writable();
+			pixelFootprints.reserve( ImagePlug::tileSize() * ImagePlug::tileSize() * g_footprintSize );
+			FloatVectorDataPtr pixelFilterWeightsData = new FloatVectorData();
+			std::vector<float> &pixelFilterWeights = pixelFilterWeightsData->writable();
+
+			for( size_t i = 0, e = pixelInputPositions.size(); i < e; ++i )
+			{
+				if( pixelInputPositions[i] != Engine::black )
+				{
+					appendFootprint( pixelInputPositions[i], pixelInputDerivatives[i].x, pixelInputDerivatives[i].y, filter, pixelFootprints, pixelFilterWeights );
+				}
+				else
+				{
+					pixelFootprints.insert( pixelFootprints.end(), g_footprintSize, 0 );
+				}
+			}
+
+			sampleRegions->members()[ g_pixelFootprintsName ] = pixelFootprintsData;
+			sampleRegions->members()[ g_pixelFilterWeightsName ] = pixelFilterWeightsData;
+		}
 		static_cast<CompoundObjectPlug *>( output )->setValue( sampleRegions );
 		return;
 	}
@@ -671,6 +734,51 @@ IECore::ConstFloatVectorDataPtr Warp::computeChannelData( const std::string &cha
 		(Sampler::BoundingMode)boundingModePlug()->getValue()
 	);
 
+	const IntVectorData *pixelFootprintsData = sampleRegions->member<IntVectorData>( g_pixelFootprintsName );
+	if( pixelFootprintsData )
+	{
+		// Fast path using the filter weights computed once for all channels
+		// in the sampleRegionsPlug().
+		const std::vector<int> &pixelFootprints = pixelFootprintsData->readable();
+		const std::vector<float> &pixelFilterWeights = sampleRegions->member<FloatVectorData>( g_pixelFilterWeightsName, true )->readable();
+
+		int i = 0;
+		V2i oP;
+		for( oP.y = 0; oP.y < ImagePlug::tileSize(); ++oP.y )
+		{
+			for( oP.x = 0; oP.x < ImagePlug::tileSize(); ++oP.x, ++i )
+			{
+				float v = 0;
+				if( BufferAlgo::contains( validPixelsRelativeToTile , oP ) && pixelInputPositions[i] != Engine::black )
+				{
+					const int *footprint = &pixelFootprints[i * g_footprintSize];
+					const float *xWeights = pixelFilterWeights.data() + footprint[4];
+					const float *yWeights = xWeights + footprint[2];
+
+					float totalW = 0.0f;
+					for( int y = 0; y < footprint[3]; ++y )
+					{
+						const float yWeight = yWeights[y];
+						for( int x = 0; x < footprint[2]; ++x )
+						{
+							const float w = xWeights[x] * yWeight;
+							totalW += w;
+							v += w * sampler.sample( footprint[0] + x, footprint[1] + y );
+						}
+					}
+
+					if( totalW != 0.0f )
+					{
+						v /= totalW;
+					}
+				}
+				result.push_back( v );
+			}
+		}
+
+		return resultData;
+	}
+
 	std::vector<float> scratchMemory;
 	int i = 0;
 	V2i oP;
@@ -107,6 +107,18 @@ void save( Catalogue::Image &image, const std::string &fileName )
 	image.save( fileName );
 }
 
+size_t memoryUsage( const Catalogue::Image &image )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return image.memoryUsage();
+}
+
+void waitForSaves()
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	Catalogue::waitForSaves();
+}
+
 std::string generateFileName1( Catalogue &catalogue, const Catalogue::Image *image )
 {
 	IECorePython::ScopedGILRelease gilRelease;
@@ -130,6 +142,8 @@ void GafferImageModule::bindCatalogue()
 			.def( "getDriver", (IECoreImage::DisplayDriver *(Display::*)())&Display::getDriver, return_value_policy<CastToIntrusivePtr>() )
 			.def( "driverCreatedSignal", &Display::driverCreatedSignal, return_value_policy<reference_existing_object>() ).staticmethod( "driverCreatedSignal" )
 			.def( "imageReceivedSignal", &Display::imageReceivedSignal, return_value_policy<reference_existing_object>() ).staticmethod( "imageReceivedSignal" )
+			.def( "setUpdateInterval", &Display::setUpdateInterval ).staticmethod( "setUpdateInterval" )
+			.def( "getUpdateInterval", &Display::getUpdateInterval ).staticmethod( "getUpdateInterval" )
 		;
 
 		SignalClass<Display::DriverCreatedSignal, DefaultSignalCaller<Display::DriverCreatedSignal>, DriverCreatedSlotCaller>( "DriverCreated" );
@@ -141,6 +155,8 @@ void GafferImageModule::bindCatalogue()
 			.def( "generateFileName", &generateFileName2 )
 			.def( "displayDriverServer", &Catalogue::displayDriverServer, return_value_policy<IECorePython::CastToIntrusivePtr>() )
 			.staticmethod( "displayDriverServer" )
+			.def( "waitForSaves", &waitForSaves )
+			.staticmethod( "waitForSaves" )
 		;
 
 		GafferBindings::PlugClass<Catalogue::Image>()
@@ -156,6 +172,7 @@ void GafferImageModule::bindCatalogue()
 			.def( "copyFrom", &copyFrom )
 			.def( "load", Catalogue::Image::load )
 			.def( "save", &save )
+			.def( "memoryUsage", &memoryUsage )
 			.staticmethod( "load" )
 			.attr( "__qualname__" ) = "Catalogue.Image"
 		;
@@ -34,6 +34,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "boost/python.hpp"
+#include "boost/python/suite/indexing/container_utils.hpp"
 
 #include "CoreBinding.h"
 
@@ -75,6 +76,36 @@ IECore::MurmurHash channelDataHash( const ImagePlug &plug, const std::string &ch
 	return plug.channelDataHash( channelName, tileOrigin );
 }
 
+boost::python::list channelDataList( const ImagePlug &plug, const boost::python::list &pythonChannelNames, const Imath::V2i &tile, bool copy )
+{
+	std::vector<std::string> channelNames;
+	container_utils::extend_container( channelNames, pythonChannelNames );
+
+	std::vector<IECore::ConstFloatVectorDataPtr> channelData;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		channelData = plug.channelData( channelNames, tile );
+	}
+
+	boost::python::list result;
+	for( const auto &d : channelData )
+	{
+		result.append( copy ? d->copy() : boost::const_pointer_cast<IECore::FloatVectorData>( d ) );
+	}
+	return result;
+}
+
+IECore::MurmurHash channelDataHashList( const ImagePlug &plug, const boost::python::list &pythonChannelNames, const Imath::V2i &tileOrigin )
+{
+	std::vector<std::string> channelNames;
+	container_utils::extend_container( channelNames, pythonChannelNames );
+
+	IECorePython::ScopedGILRelease gilRelease;
+	IECore::MurmurHash result;
+	plug.channelDataHash( channelNames, tileOrigin, result );
+	return result;
+}
+
 IECoreImage::ImagePrimitivePtr image( const ImagePlug &plug )
 {
 	IECorePython::ScopedGILRelease gilRelease;
@@ -188,7 +219,9 @@ void GafferImageModule::bindCore()
 			)
 		)
 		.def( "channelData", &channelData, ( arg( "_copy" ) = true ) )
+		.def( "channelData", &channelDataList, ( arg( "_copy" ) = true ) )
 		.def( "channelDataHash", &channelDataHash )
+		.def( "channelDataHash", &channelDataHashList )
 		.def( "image", &image )
 		.def( "imageHash", &imageHash )
 		.def( "tileSize", &ImagePlug::tileSize ).staticmethod( "tileSize" )
@@ -78,6 +78,9 @@ ImageGadget::ImageGadget()
 		m_soloChannel( -1 ),
 		m_paused( false ),
 		m_dirtyFlags( AllDirty ),
+		m_mipLevel( 0 ),
+		m_tilesMipLevel( 0 ),
+		m_fallbackMipLevel( -1 ),
 		m_renderRequestPending( false )
 {
 	m_rgbaChannels[0] = "R";
@@ -376,33 +379,154 @@ const std::vector<std::string> &ImageGadget::channelNames() const
 // Tile storage
 //////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////
+// Texture atlas
+//////////////////////////////////////////////////////////////////////////
+
 namespace
 {
 
-IECoreGL::Texture *blackTexture()
+// Each page of the atlas is a single texture holding a grid of tiles.
+// Pages are shared by all ImageGadgets, and are only accessed on the
+// UI thread.
+const int g_atlasPageSize = 2048;
+
+int atlasTilesPerRow()
+{
+	return g_atlasPageSize / ImagePlug::tileSize();
+}
+
+struct AtlasPage
+{
+	IECoreGL::TexturePtr texture;
+	std::vector<int> freeSlots;
+};
+
+std::vector<AtlasPage> &atlasPages()
+{
+	// We deliberately make no attempt to free this, because slots may
+	// still be released by gadgets destroyed during static destruction,
+	// and there is no GL context to free the textures in by then anyway.
+	static std::vector<AtlasPage> *g_pages = new std::vector<AtlasPage>;
+	return *g_pages;
+}
+
+} // namespace
+
+struct ImageGadget::AtlasSlot
 {
-	static IECoreGL::TexturePtr g_texture;
-	if( !g_texture )
+
+	AtlasSlot()
+	{
+		std::vector<AtlasPage> &pages = atlasPages();
+		for( pageIndex = 0; pageIndex < pages.size(); ++pageIndex )
+		{
+			if( !pages[pageIndex].texture || pages[pageIndex].freeSlots.size() )
+			{
+				break;
+			}
+		}
+
+		if( pageIndex == pages.size() )
+		{
+			pages.push_back( AtlasPage() );
+		}
+
+		AtlasPage &page = pages[pageIndex];
+		if( !page.texture )
+		{
+			GLuint texture;
+			glGenTextures( 1, &texture );
+			page.texture = new Texture( texture );
+			Texture::ScopedBinding binding( *page.texture );
+
+			glTexImage2D(
+				GL_TEXTURE_2D, 0, GL_LUMINANCE, g_atlasPageSize, g_atlasPageSize, 0, GL_LUMINANCE,
+				GL_FLOAT, nullptr
+			);
+
+			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+
+			// Reverse order so that we fill the page from the start.
+			const int numSlots = atlasTilesPerRow() * atlasTilesPerRow();
+			page.freeSlots.reserve( numSlots );
+			for( int i = numSlots - 1; i >= 0; --i )
+			{
+				page.freeSlots.push_back( i );
+			}
+		}
+
+		texture = page.texture.get();
+		slotIndex = page.freeSlots.back();
+		page.freeSlots.pop_back();
+
+		origin = V2i( slotIndex % atlasTilesPerRow(), slotIndex / atlasTilesPerRow() ) * ImagePlug::tileSize();
+		uvOrigin = V2f( origin ) / g_atlasPageSize;
+		uvSize = (float)ImagePlug::tileSize() / g_atlasPageSize;
+	}
+
+	~AtlasSlot()
 	{
-		GLuint texture;
-		glGenTextures( 1, &texture );
-		g_texture = new Texture( texture );
-		Texture::ScopedBinding binding( *g_texture );
+		AtlasPage &page = atlasPages()[pageIndex];
+		page.freeSlots.push_back( slotIndex );
+		if( (int)page.freeSlots.size() == atlasTilesPerRow() * atlasTilesPerRow() )
+		{
+			// Page is no longer used, so release the memory.
+			page.texture = nullptr;
+			page.freeSlots.clear();
+		}
+	}
 
-		const float black = 0;
+	void upload( const float *data )
+	{
+		Texture::ScopedBinding binding( *texture );
 		glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
-		glTexImage2D( GL_TEXTURE_2D, 0, GL_LUMINANCE, /* width = */ 1, /* height = */ 1, 0, GL_LUMINANCE,
-			GL_FLOAT, &black );
+		glTexSubImage2D(
+			GL_TEXTURE_2D, 0, origin.x, origin.y, ImagePlug::tileSize(), ImagePlug::tileSize(), GL_LUMINANCE,
+			GL_FLOAT, data
+		);
 	}
-	return g_texture.get();
-}
 
-} // namespace
+	V2f uv( const V2f &tileUV ) const
+	{
+		return uvOrigin + tileUV * uvSize;
+	}
+
+	// Used for tiles which haven't been computed yet. Leaked for
+	// the same reasons as `atlasPages()`, so that its page is never
+	// released.
+	static const AtlasSlot *black()
+	{
+		static AtlasSlot *g_slot = nullptr;
+		if( !g_slot )
+		{
+			g_slot = new AtlasSlot;
+			const std::vector<float> black( ImagePlug::tileSize() * ImagePlug::tileSize(), 0.0f );
+			g_slot->upload( black.data() );
+		}
+		return g_slot;
+	}
+
+	const IECoreGL::Texture *texture;
+	size_t pageIndex;
+	int slotIndex;
+	V2i origin;
+	V2f uvOrigin;
+	float uvSize;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Tile
+//////////////////////////////////////////////////////////////////////////
 
 ImageGadget::Tile::Tile( const Tile &other )
 	:	m_channelDataHash( other.m_channelDataHash ),
 		m_channelDataToConvert( other.m_channelDataToConvert ),
-		m_texture( other.m_texture ),
+		m_atlasSlot( other.m_atlasSlot ),
 		m_active( false )
 {
 }
@@ -452,7 +576,7 @@ void ImageGadget::Tile::applyUpdates( const std::vector<Update> &updates )
 	}
 }
 
-const IECoreGL::Texture *ImageGadget::Tile::texture( bool &active )
+const ImageGadget::AtlasSlot *ImageGadget::Tile::atlasSlot( bool &active )
 {
 	const auto now = std::chrono::steady_clock::now();
 	Mutex::scoped_lock lock( m_mutex );
@@ -469,24 +593,17 @@ const IECoreGL::Texture *ImageGadget::Tile::texture( bool &active )
 
 	if( channelDataToConvert )
 	{
-		GLuint texture;
-		glGenTextures( 1, &texture );
-		m_texture = new Texture( texture ); // Lock not needed, because this is only touched on the UI thread.
-		Texture::ScopedBinding binding( *m_texture );
-
-		glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
-		glTexImage2D(
-			GL_TEXTURE_2D, 0, GL_LUMINANCE, ImagePlug::tileSize(), ImagePlug::tileSize(), 0, GL_LUMINANCE,
-			GL_FLOAT, channelDataToConvert->readable().data()
-		);
-
-		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
-		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
-		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
-		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+		// Lock not needed, because the slot is only touched on the UI thread.
+		// We reuse any existing slot, rather than allocate a new one, so
+		// progressive updates just overwrite the pixels in place.
+		if( !m_atlasSlot )
+		{
+			m_atlasSlot = std::make_shared<AtlasSlot>();
+		}
+		m_atlasSlot->upload( channelDataToConvert->readable().data() );
 	}
 
-	return m_texture ? m_texture.get() : blackTexture();
+	return m_atlasSlot ? m_atlasSlot.get() : AtlasSlot::black();
 }
 
 // Needed to allow TileIndex to be used as a key in concurrent_unordered_map.
@@ -495,7 +612,43 @@ inline size_t GafferImageUI::tbb_hasher( const ImageGadget::TileIndex &tileIndex
 	return
 		tbb::tbb_hasher( tileIndex.tileOrigin.x ) ^
 		tbb::tbb_hasher( tileIndex.tileOrigin.y ) ^
-		tbb::tbb_hasher( tileIndex.channelName.c_str() );
+		tbb::tbb_hasher( tileIndex.channelName.c_str() ) ^
+		tbb::tbb_hasher( tileIndex.mipLevel );
+}
+
+void ImageGadget::updateMipLevel()
+{
+	const ViewportGadget *viewport = ancestor<ViewportGadget>();
+	if( !viewport )
+	{
+		return;
+	}
+
+	// Choose the lowest resolution at which each displayed pixel
+	// still covers no more than a single pixel on screen.
+
+	const float rasterPixelsPerPixel = (
+		viewport->gadgetToRasterSpace( V3f( 0, 1, 0 ), this ) -
+		viewport->gadgetToRasterSpace( V3f( 0 ), this )
+	).length();
+
+	const int maxMipLevel = 8;
+	int mipLevel = 0;
+	while( mipLevel < maxMipLevel && rasterPixelsPerPixel * (float)( 1 << ( mipLevel + 1 ) ) <= 1.0f )
+	{
+		mipLevel++;
+	}
+
+	if( mipLevel == m_mipLevel )
+	{
+		return;
+	}
+
+	// Cancel any update for the previous level, and make sure
+	// that `updateTiles()` starts a new one.
+	m_mipLevel = mipLevel;
+	m_tilesTask.reset();
+	m_dirtyFlags |= TilesDirty;
 }
 
 void ImageGadget::updateTiles()
@@ -519,6 +672,36 @@ void ImageGadget::updateTiles()
 		}
 	}
 
+	const int previousMipLevel = m_tilesMipLevel;
+	const Box2i previousDataWindow = m_tilesDataWindow;
+
+	Context::EditableScope mipLevelScope( m_context.get() );
+	if( m_mipLevel && m_image )
+	{
+		mipLevelScope.set( ImagePlug::mipLevelContextName, m_mipLevel );
+		m_tilesDataWindow = m_image->dataWindowPlug()->getValue();
+	}
+	else
+	{
+		m_tilesDataWindow = this->dataWindow();
+	}
+	m_tilesMipLevel = m_mipLevel;
+
+	if( m_tilesMipLevel == m_fallbackMipLevel )
+	{
+		// Zoomed back to the level we were falling back to,
+		// so its tiles are now the ones being updated.
+		m_fallbackMipLevel = -1;
+	}
+	else if( m_tilesMipLevel != previousMipLevel && m_fallbackMipLevel == -1 )
+	{
+		// Keep the previous level to draw until the new one is
+		// complete. If we already have a fallback, then the previous
+		// level was never completed, so we keep the fallback instead.
+		m_fallbackMipLevel = previousMipLevel;
+		m_fallbackDataWindow = previousDataWindow;
+	}
+
 	stateChangedSignal()( this );
 	removeOutOfBoundsTiles();
 
@@ -538,19 +721,20 @@ void ImageGadget::updateTiles()
 		}
 	}
 
-	const Box2i dataWindow = this->dataWindow();
+	const Box2i dataWindow = m_tilesDataWindow;
+	const int mipLevel = m_tilesMipLevel;
 
 	// Do the actual work of generating the tiles asynchronously,
 	// in the background.
 
-	auto tileFunctor = [this, channelsToCompute] ( const ImagePlug *image, const V2i &tileOrigin ) {
+	auto tileFunctor = [this, channelsToCompute, mipLevel] ( const ImagePlug *image, const V2i &tileOrigin ) {
 
 		vector<Tile::Update> updates;
 		ImagePlug::ChannelDataScope channelScope( Context::current() );
 		for( auto &channelName : channelsToCompute )
 		{
 			channelScope.setChannelName( channelName );
-			Tile &tile = m_tiles[TileIndex(tileOrigin, channelName)];
+			Tile &tile = m_tiles[TileIndex(tileOrigin, channelName, mipLevel)];
 			updates.push_back( tile.computeUpdate( image ) );
 		}
 
@@ -569,20 +753,27 @@ void ImageGadget::updateTiles()
 		}
 	};
 
-	Context::Scope scopedContext( m_context.get() );
 	m_tilesTask = ParallelAlgo::callOnBackgroundThread(
 		// Subject
 		m_image.get(),
 		// OK to capture `this` via raw pointer, because ~ImageGadget waits for
 		// the background process to complete.
-		[this, channelsToCompute, dataWindow, tileFunctor] {
+		[this, channelsToCompute, dataWindow, mipLevel, tileFunctor] {
 			ImageAlgo::parallelProcessTiles( m_image.get(), tileFunctor, dataWindow );
 			m_dirtyFlags &= ~TilesDirty;
 			if( refCount() )
 			{
 				ImageGadgetPtr thisRef = this;
 				ParallelAlgo::callOnUIThread(
-					[thisRef] {
+					[thisRef, mipLevel] {
+						if( mipLevel == thisRef->m_tilesMipLevel )
+						{
+							// All tiles for the level are now available, so we
+							// no longer need the fallback. Its tiles are pruned
+							// by the next call to `removeOutOfBoundsTiles()`.
+							thisRef->m_fallbackMipLevel = -1;
+							thisRef->requestRender();
+						}
 						thisRef->stateChangedSignal()( thisRef.get() );
 					}
 				);
@@ -600,13 +791,26 @@ void ImageGadget::removeOutOfBoundsTiles() const
 	// we don't want to accumulate unbounded numbers of tiles either,
 	// so here we prune out any tiles that we know can't be useful for
 	// the current image, because they either have an invalid channel
-	// name or are outside the data window.
-	const Box2i &dw = dataWindow();
+	// name, are outside the data window or are for a mip level that
+	// we are neither updating nor falling back to.
 	const vector<string> &ch = channelNames();
 	for( Tiles::iterator it = m_tiles.begin(); it != m_tiles.end(); )
 	{
 		const Box2i tileBound( it->first.tileOrigin, it->first.tileOrigin + V2i( ImagePlug::tileSize() ) );
-		if( !BufferAlgo::intersects( dw, tileBound ) || find( ch.begin(), ch.end(), it->first.channelName.string() ) == ch.end() )
+		bool keep = false;
+		if( it->first.mipLevel == m_tilesMipLevel )
+		{
+			keep = BufferAlgo::intersects( m_tilesDataWindow, tileBound );
+		}
+		else if( it->first.mipLevel == m_fallbackMipLevel )
+		{
+			keep = BufferAlgo::intersects( m_fallbackDataWindow, tileBound );
+		}
+
+		if(
+			!keep ||
+			find( ch.begin(), ch.end(), it->first.channelName.string() ) == ch.end()
+		)
 		{
 			it = m_tiles.unsafe_erase( it );
 		}
@@ -624,6 +828,13 @@ void ImageGadget::removeOutOfBoundsTiles() const
 namespace
 {
 
+// A divide that always rounds down, instead of towards zero.
+int floorDivide( int a, int b )
+{
+	int result = a / b;
+	return result - ( a - result * b < 0 );
+}
+
 const char *vertexSource()
 {
 	static const char *g_vertexSource =
@@ -631,6 +842,10 @@ const char *vertexSource()
 	"{"
 	"	gl_Position = gl_ProjectionMatrix * gl_ModelViewMatrix * gl_Vertex;"
 	"	gl_TexCoord[0] = gl_MultiTexCoord0;"
+	"	gl_TexCoord[1] = gl_MultiTexCoord1;"
+	"	gl_TexCoord[2] = gl_MultiTexCoord2;"
+	"	gl_TexCoord[3] = gl_MultiTexCoord3;"
+	"	gl_TexCoord[4] = gl_MultiTexCoord4;"
 	"}";
 
 	return g_vertexSource;
@@ -648,8 +863,6 @@ const std::string &fragmentSource()
 		"uniform sampler2D blueTexture;\n"
 		"uniform sampler2D alphaTexture;\n"
 
-		"uniform bool active;\n"
-
 		"#if __VERSION__ >= 330\n"
 
 		"layout( location=0 ) out vec4 outColor;\n"
@@ -665,18 +878,21 @@ const std::string &fragmentSource()
 
 		"void main()"
 		"{"
+		// Coordinates 0-3 address the atlas slots for each
+		// channel, and coordinate 4 holds the coordinates within
+		// the tile, with the active flag in z.
 		"	OUTCOLOR = vec4(\n"
 		"		texture2D( redTexture, gl_TexCoord[0].xy ).r,\n"
-		"		texture2D( greenTexture, gl_TexCoord[0].xy ).r,\n"
-		"		texture2D( blueTexture, gl_TexCoord[0].xy ).r,\n"
-		"		texture2D( alphaTexture, gl_TexCoord[0].xy ).r\n"
+		"		texture2D( greenTexture, gl_TexCoord[1].xy ).r,\n"
+		"		texture2D( blueTexture, gl_TexCoord[2].xy ).r,\n"
+		"		texture2D( alphaTexture, gl_TexCoord[3].xy ).r\n"
 		"	);\n"
 
-		"	if( active )\n"
+		"	if( gl_TexCoord[4].z > 0.5 )\n"
 		"	{\n"
-		"		vec2 pixelWidth = vec2( dFdx( gl_TexCoord[0].x ), dFdy( gl_TexCoord[0].y ) );\n"
+		"		vec2 pixelWidth = vec2( dFdx( gl_TexCoord[4].x ), dFdy( gl_TexCoord[4].y ) );\n"
 		"		float aspect = pixelWidth.x / pixelWidth.y;\n"
-		"		vec2 p = abs( gl_TexCoord[0].xy - vec2( 0.5 ) );\n"
+		"		vec2 p = abs( gl_TexCoord[4].xy - vec2( 0.5 ) );\n"
 		"		float eX = step( 0.5 - pixelWidth.x, p.x ) * step( 0.5 - ACTIVE_CORNER_RADIUS, p.y );\n"
 		"		float eY = step( 0.5 - pixelWidth.y, p.y ) * step( 0.5 - ACTIVE_CORNER_RADIUS * aspect, p.x );\n"
 		"		float e = eX + eY - eX * eY;\n"
@@ -740,66 +956,188 @@ void ImageGadget::renderTiles() const
 	glUniform1i( shader->uniformParameter( "blueTexture" )->location, textureUnits[2] );
 	glUniform1i( shader->uniformParameter( "alphaTexture" )->location, textureUnits[3] );
 
-	GLint activeParameterLocation = shader->uniformParameter( "active" )->location;
-
 	const Box2i dataWindow = this->dataWindow();
 	const float pixelAspect = this->format().getPixelAspect();
 
-	V2i tileOrigin = ImagePlug::tileOrigin( dataWindow.min );
-	for( ; tileOrigin.y < dataWindow.max.y; tileOrigin.y += ImagePlug::tileSize() )
+	// Tiles are stored at the resolution of the mip level, but
+	// we draw them at full resolution.
+	const Box2i &tilesDataWindow = m_tilesDataWindow;
+	const int factor = 1 << m_tilesMipLevel;
+
+	// First pass : upload any pending tile updates into the atlas,
+	// and find the slot holding each channel of each tile. This can't
+	// be done while drawing, because GL doesn't allow uploads between
+	// `glBegin()` and `glEnd()`.
+
+	struct TileToDraw
+	{
+		const AtlasSlot *slots[4];
+		Box2i validBound;
+		Box2f uvBound;
+		bool active;
+	};
+
+	vector<TileToDraw> tilesToDraw;
+
+	InternedString tileChannels[4];
+	bool channelExists[4];
+	const vector<string> &availableChannels = this->channelNames();
+	for( int i = 0; i < 4; ++i )
 	{
-		for( tileOrigin.x = ImagePlug::tileOrigin( dataWindow.min ).x; tileOrigin.x < dataWindow.max.x; tileOrigin.x += ImagePlug::tileSize() )
+		tileChannels[i] = m_soloChannel == -1 ? m_rgbaChannels[i] : m_rgbaChannels[m_soloChannel];
+		channelExists[i] = find( availableChannels.begin(), availableChannels.end(), tileChannels[i].string() ) != availableChannels.end();
+	}
+
+	// Finds the slots for a tile, returning true if all the
+	// channels that exist have been computed.
+	auto findSlots = [this, &tileChannels, &channelExists] ( const V2i &tileOrigin, int mipLevel, TileToDraw &tile ) -> bool {
+		bool ready = true;
+		for( int i = 0; i < 4; ++i )
 		{
-			bool active = false;
-			for( int i = 0; i < 4; ++i )
+			Tiles::const_iterator it = m_tiles.find( TileIndex( tileOrigin, tileChannels[i], mipLevel ) );
+			if( it != m_tiles.end() )
 			{
-				glActiveTexture( GL_TEXTURE0 + textureUnits[i] );
-				const InternedString channelName = m_soloChannel == -1 ? m_rgbaChannels[i] : m_rgbaChannels[m_soloChannel];
-				Tiles::const_iterator it = m_tiles.find( TileIndex( tileOrigin, channelName ) );
-				if( it != m_tiles.end() )
-				{
-					it->second.texture( active )->bind();
-				}
-				else
-				{
-					blackTexture()->bind();
-				}
+				tile.slots[i] = it->second.atlasSlot( tile.active );
+			}
+			else
+			{
+				tile.slots[i] = AtlasSlot::black();
 			}
+			ready = ready && ( !channelExists[i] || tile.slots[i] != AtlasSlot::black() );
+		}
+		return ready;
+	};
 
-			glUniform1i( activeParameterLocation, active );
+	// Sets the bounds for drawing the part of a tile covering `clip`.
+	// Bounds are in full resolution pixels.
+	auto setBounds = [] ( const Box2i &tileBound, const Box2i &clip, TileToDraw &tile ) {
+		tile.validBound = BufferAlgo::intersection( tileBound, clip );
+		tile.uvBound = Box2f(
+			V2f(
+				lerpfactor<float>( tile.validBound.min.x, tileBound.min.x, tileBound.max.x ),
+				lerpfactor<float>( tile.validBound.min.y, tileBound.min.y, tileBound.max.y )
+			),
+			V2f(
+				lerpfactor<float>( tile.validBound.max.x, tileBound.min.x, tileBound.max.x ),
+				lerpfactor<float>( tile.validBound.max.y, tileBound.min.y, tileBound.max.y )
+			)
+		);
+	};
+
+	const int fallbackFactor = 1 << std::max( m_fallbackMipLevel, 0 );
+
+	V2i tileOrigin = ImagePlug::tileOrigin( tilesDataWindow.min );
+	for( ; tileOrigin.y < tilesDataWindow.max.y; tileOrigin.y += ImagePlug::tileSize() )
+	{
+		for( tileOrigin.x = ImagePlug::tileOrigin( tilesDataWindow.min ).x; tileOrigin.x < tilesDataWindow.max.x; tileOrigin.x += ImagePlug::tileSize() )
+		{
+			TileToDraw tile;
+			tile.active = false;
+			const bool ready = findSlots( tileOrigin, m_tilesMipLevel, tile );
+
+			const Box2i tileBound( tileOrigin * factor, ( tileOrigin + V2i( ImagePlug::tileSize() ) ) * factor );
+			if( ready || m_fallbackMipLevel == -1 )
+			{
+				setBounds( tileBound, dataWindow, tile );
+				tilesToDraw.push_back( tile );
+				continue;
+			}
+
+			// The tile hasn't been computed yet, so draw the parts of
+			// the fallback tiles which cover it instead.
 
-			const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
-			const Box2i validBound = BufferAlgo::intersection( tileBound, dataWindow );
-			const Box2f uvBound(
-				V2f(
-					lerpfactor<float>( validBound.min.x, tileBound.min.x, tileBound.max.x ),
-					lerpfactor<float>( validBound.min.y, tileBound.min.y, tileBound.max.y )
+			const Box2i clip = BufferAlgo::intersection( tileBound, dataWindow );
+			const Box2i fallbackPixels = BufferAlgo::intersection(
+				Box2i(
+					V2i( floorDivide( clip.min.x, fallbackFactor ), floorDivide( clip.min.y, fallbackFactor ) ),
+					V2i( -floorDivide( -clip.max.x, fallbackFactor ), -floorDivide( -clip.max.y, fallbackFactor ) )
 				),
-				V2f(
-					lerpfactor<float>( validBound.max.x, tileBound.min.x, tileBound.max.x ),
-					lerpfactor<float>( validBound.max.y, tileBound.min.y, tileBound.max.y )
-				)
+				m_fallbackDataWindow
 			);
 
-			glBegin( GL_QUADS );
-
-				glTexCoord2f( uvBound.min.x, uvBound.min.y  );
-				glVertex2f( validBound.min.x * pixelAspect, validBound.min.y );
+			if( BufferAlgo::empty( fallbackPixels ) )
+			{
+				continue;
+			}
 
-				glTexCoord2f( uvBound.min.x, uvBound.max.y  );
-				glVertex2f( validBound.min.x * pixelAspect, validBound.max.y );
+			V2i fallbackOrigin = ImagePlug::tileOrigin( fallbackPixels.min );
+			for( ; fallbackOrigin.y < fallbackPixels.max.y; fallbackOrigin.y += ImagePlug::tileSize() )
+			{
+				for( fallbackOrigin.x = ImagePlug::tileOrigin( fallbackPixels.min ).x; fallbackOrigin.x < fallbackPixels.max.x; fallbackOrigin.x += ImagePlug::tileSize() )
+				{
+					TileToDraw fallbackTile;
+					fallbackTile.active = tile.active;
+					findSlots( fallbackOrigin, m_fallbackMipLevel, fallbackTile );
+					setBounds(
+						Box2i( fallbackOrigin * fallbackFactor, ( fallbackOrigin + V2i( ImagePlug::tileSize() ) ) * fallbackFactor ),
+						clip, fallbackTile
+					);
+					tilesToDraw.push_back( fallbackTile );
+				}
+			}
+		}
+	}
 
-				glTexCoord2f( uvBound.max.x, uvBound.max.y  );
-				glVertex2f( validBound.max.x * pixelAspect, validBound.max.y );
+	// Second pass : draw the tiles. We only need to break the batch of
+	// quads when a tile lives on different atlas pages to the previous one.
 
-				glTexCoord2f( uvBound.max.x, uvBound.min.y  );
-				glVertex2f( validBound.max.x * pixelAspect, validBound.min.y );
+	const Texture *boundPages[4] = { nullptr, nullptr, nullptr, nullptr };
+	bool drawing = false;
+	for( const auto &tile : tilesToDraw )
+	{
+		bool pagesChanged = false;
+		for( int i = 0; i < 4; ++i )
+		{
+			pagesChanged = pagesChanged || tile.slots[i]->texture != boundPages[i];
+		}
 
-			glEnd();
+		if( pagesChanged )
+		{
+			if( drawing )
+			{
+				glEnd();
+			}
+			for( int i = 0; i < 4; ++i )
+			{
+				glActiveTexture( GL_TEXTURE0 + textureUnits[i] );
+				tile.slots[i]->texture->bind();
+				boundPages[i] = tile.slots[i]->texture;
+			}
+			glBegin( GL_QUADS );
+			drawing = true;
+		}
 
+		const V2f corners[4] = {
+			V2f( tile.uvBound.min.x, tile.uvBound.min.y ),
+			V2f( tile.uvBound.min.x, tile.uvBound.max.y ),
+			V2f( tile.uvBound.max.x, tile.uvBound.max.y ),
+			V2f( tile.uvBound.max.x, tile.uvBound.min.y )
+		};
+
+		const V2f vertices[4] = {
+			V2f( tile.validBound.min.x * pixelAspect, tile.validBound.min.y ),
+			V2f( tile.validBound.min.x * pixelAspect, tile.validBound.max.y ),
+			V2f( tile.validBound.max.x * pixelAspect, tile.validBound.max.y ),
+			V2f( tile.validBound.max.x * pixelAspect, tile.validBound.min.y )
+		};
+
+		for( int c = 0; c < 4; ++c )
+		{
+			for( int i = 0; i < 4; ++i )
+			{
+				const V2f uv = tile.slots[i]->uv( corners[c] );
+				glMultiTexCoord2f( GL_TEXTURE0 + i, uv.x, uv.y );
+			}
+			glMultiTexCoord3f( GL_TEXTURE4, corners[c].x, corners[c].y, tile.active ? 1.0f : 0.0f );
+			glVertex2f( vertices[c].x, vertices[c].y );
 		}
 	}
 
+	if( drawing )
+	{
+		glEnd();
+	}
+
 	glUseProgram( previousProgram );
 }
 
@@ -841,6 +1179,7 @@ void ImageGadget::doRenderLayer( Layer layer, const GafferUI::Style *style ) con
 	{
 		format = this->format();
 		dataWindow = this->dataWindow();
+		const_cast<ImageGadget *>( this )->updateMipLevel();
 		const_cast<ImageGadget *>( this )->updateTiles();
 	}
 	catch( ... )
@@ -45,8 +45,10 @@
 
 #include "boost/filesystem.hpp"
 
-#include "tbb/concurrent_unordered_map.h"
 #include "tbb/mutex.h"
+#include "tbb/spin_mutex.h"
+
+#include <memory>
 
 using namespace std;
 using namespace IECore;
@@ -57,6 +59,9 @@ using namespace GafferScene;
 namespace
 {
 
+// Writes each location as soon as it has been computed. This is used
+// when computing a single frame at a time, so that we never need to
+// hold more than a few locations in memory.
 struct LocationWriter
 {
 	LocationWriter(SceneInterfacePtr output, ConstCompoundDataPtr sets, float time, tbb::mutex& mutex) : m_output( output ), m_sets(sets), m_time( time ), m_mutex( mutex )
@@ -149,8 +154,124 @@ struct LocationWriter
 	tbb::mutex &m_mutex;
 };
 
+// Computing the scene for a frame is independent of all other frames,
+// and can be done in parallel, but the frames must be written in order.
+// So we gather the data for each location into a LocationData tree,
+// which is then written serially.
+struct LocationData
+{
+	IECore::InternedString name;
+	ConstCompoundObjectPtr attributes;
+	ConstCompoundObjectPtr globals;
+	ConstObjectPtr object;
+	Imath::Box3f bound;
+	IECore::M44dDataPtr transform;
+	SceneInterface::NameList sets;
+
+	tbb::spin_mutex childrenMutex;
+	std::vector<std::unique_ptr<LocationData>> children;
+};
+
+typedef std::shared_ptr<LocationData> LocationDataPtr;
+
+struct LocationGatherer
+{
+	LocationGatherer( ConstCompoundDataPtr sets, LocationData *location ) : m_sets( sets ), m_location( location )
+	{
+	}
+
+	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &scenePath )
+	{
+		LocationData *location = m_location;
+		if( !scenePath.empty() )
+		{
+			// `m_location` is our parent, as set by the functor
+			// we were copied from.
+			location = new LocationData;
+			location->name = scenePath.back();
+			tbb::spin_mutex::scoped_lock lock( m_location->childrenMutex );
+			m_location->children.push_back( std::unique_ptr<LocationData>( location ) );
+		}
+		// Our children will be visited by copies of this functor.
+		m_location = location;
+
+		location->attributes = scene->attributesPlug()->getValue();
+		location->object = scene->objectPlug()->getValue();
+		location->bound = scene->boundPlug()->getValue();
+
+		if( scenePath.empty() )
+		{
+			location->globals = scene->globalsPlug()->getValue();
+		}
+		else
+		{
+			Imath::M44f t = scene->transformPlug()->getValue();
+			location->transform = new IECore::M44dData( Imath::M44d (
+				t[0][0], t[0][1], t[0][2], t[0][3],
+				t[1][0], t[1][1], t[1][2], t[1][3],
+				t[2][0], t[2][1], t[2][2], t[2][3],
+				t[3][0], t[3][1], t[3][2], t[3][3]
+			) );
+		}
+
+		const CompoundDataMap &setsMap = m_sets->readable();
+		location->sets.reserve( setsMap.size() );
+
+		for( CompoundDataMap::const_iterator it = setsMap.begin(); it != setsMap.end(); ++it)
+		{
+			ConstPathMatcherDataPtr pathMatcher = IECore::runTimeCast<PathMatcherData>( it->second );
+
+			if( pathMatcher->readable().match( scenePath ) & IECore::PathMatcher::ExactMatch )
+			{
+				location->sets.push_back( it->first );
+			}
+		}
+
+		return true;
+	}
+
+	ConstCompoundDataPtr m_sets;
+	LocationData *m_location;
+};
+
+void writeLocation( const LocationData *location, SceneInterface *output, double time, bool root )
+{
+	for( CompoundObject::ObjectMap::const_iterator it = location->attributes->members().begin(), eIt = location->attributes->members().end(); it != eIt; it++ )
+	{
+		output->writeAttribute( it->first, it->second.get(), time );
+	}
+
+	if( location->globals && !location->globals->members().empty() )
+	{
+		output->writeAttribute( "gaffer:globals", location->globals.get(), time );
+	}
+
+	if( location->object->typeId() != IECore::NullObjectTypeId && !root )
+	{
+		output->writeObject( location->object.get(), time );
+	}
+
+	output->writeBound( Imath::Box3d( Imath::V3f( location->bound.min ), Imath::V3f( location->bound.max ) ), time );
+
+	if( location->transform )
+	{
+		output->writeTransform( location->transform.get(), time );
+	}
+
+	if( !location->sets.empty() )
+	{
+		output->writeTags( location->sets );
+	}
+
+	for( const auto &child : location->children )
+	{
+		SceneInterfacePtr childOutput = output->child( child->name, SceneInterface::CreateIfMissing );
+		writeLocation( child.get(), childOutput.get(), time, /* root = */ false );
+	}
 }
 
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( SceneWriter );
 
 size_t SceneWriter::g_firstPlugIndex = 0;
@@ -162,6 +283,7 @@ SceneWriter::SceneWriter( const std::string &name )
 	addChild( new ScenePlug( "in", Plug::In ) );
 	addChild( new StringPlug( "fileName" ) );
 	addChild( new ScenePlug( "out", Plug::Out, Plug::Default & ~Plug::Serialisable ) );
+	addChild( new IntPlug( "concurrentFrames", Plug::In, 1, 1 ) );
 	outPlug()->setInput( inPlug() );
 }
 
@@ -199,6 +321,16 @@ const ScenePlug *SceneWriter::outPlug() const
 	return getChild<ScenePlug>( g_firstPlugIndex + 2 );
 }
 
+IntPlug *SceneWriter::concurrentFramesPlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 3 );
+}
+
+const IntPlug *SceneWriter::concurrentFramesPlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 3 );
+}
+
 IECore::MurmurHash SceneWriter::hash( const Gaffer::Context *context ) const
 {
 	Context::Scope scope( context );
@@ -234,19 +366,39 @@ void SceneWriter::executeSequence( const std::vector<float> &frames ) const
 	const std::string fileName = fileNamePlug()->getValue();
 	createDirectories( fileName );
 	SceneInterfacePtr output = SceneInterface::create( fileName, IndexedIO::Write );
-	tbb::mutex mutex;
-	ContextPtr context = new Context( *Context::current() );
-	Context::Scope scopedContext( context.get() );
 
-	for( std::vector<float>::const_iterator it = frames.begin(); it != frames.end(); ++it )
+	const int concurrentFrames = concurrentFramesPlug()->getValue();
+	if( concurrentFrames <= 1 || frames.size() <= 1 )
 	{
-		context->setFrame( *it );
+		tbb::mutex mutex;
+		ContextPtr context = new Context( *Context::current() );
+		Context::Scope scopedContext( context.get() );
 
-		ConstCompoundDataPtr sets = SceneAlgo::sets( scene );
-		LocationWriter locationWriter( output, sets, context->getTime(), mutex );
+		for( std::vector<float>::const_iterator it = frames.begin(); it != frames.end(); ++it )
+		{
+			context->setFrame( *it );
+
+			ConstCompoundDataPtr sets = SceneAlgo::sets( scene );
+			LocationWriter locationWriter( output, sets, context->getTime(), mutex );
 
-		SceneAlgo::parallelProcessLocations( scene, locationWriter );
+			SceneAlgo::parallelProcessLocations( scene, locationWriter );
+		}
+		return;
 	}
+
+	parallelExecuteSequence(
+		frames,
+		[scene] () {
+			LocationDataPtr root = std::make_shared<LocationData>();
+			LocationGatherer locationGatherer( SceneAlgo::sets( scene ), root.get() );
+			SceneAlgo::parallelProcessLocations( scene, locationGatherer );
+			return root;
+		},
+		[&output] ( const LocationDataPtr &root ) {
+			writeLocation( root.get(), output.get(), Context::current()->getTime(), /* root = */ true );
+		},
+		concurrentFrames
+	);
 }
 
 bool SceneWriter::requiresSequenceExecution() const